@@ -0,0 +1,133 @@
+# Auto-tuned strategies: optimal isogeny and Pohlig-Hellman strategies from measured costs on the build machine
+import pathlib
+import re
+import subprocess
+
+import click
+
+PRIMES = [377, 434, 503, 546, 610, 697, 751]
+
+# Report titles of tests/benchmark_strategy.c
+TIMER_OVERHEAD = 'Strategy timer overhead'
+ALICE_MULTIPLICATION = 'Strategy Alice point multiplication'
+ALICE_EVALUATION = 'Strategy Alice isogeny evaluation pair'
+BOB_MULTIPLICATION = 'Strategy Bob point multiplication'
+BOB_EVALUATION = 'Strategy Bob isogeny evaluation pair'
+POHLIG_HELLMAN_MULTIPLICATION = 'Strategy Pohlig-Hellman point multiplication'
+POHLIG_HELLMAN_EVALUATION = 'Strategy Pohlig-Hellman evaluation nine digits'
+
+
+def dpa(n: int, p: float, q: float):
+    """
+    dynamic programming algorithm for optimal strategy search
+    :param n: number of leaves (isogenies or Pohlig-Hellman digits)
+    :param p: cost of one step down (point multiplication)
+    :param q: cost of one step right (isogeny evaluation or Pohlig-Hellman digit removal)
+    :return: strategy and its cost
+    """
+    strategy = {1: []}
+    cost = {1: 0.00}
+    for i in range(2, n + 1):
+        b, c = min(((b, cost[i - b] + cost[b] + b * p + (i - b) * q) for b in range(1, i)), key=lambda t: t[1])
+        strategy[i] = [b] + strategy[i - b] + strategy[b]
+        cost[i] = c
+
+    return strategy[n], cost[n]
+
+
+def maximum_internal_points(n: int, strategy: list):
+    """
+    simulates the strategy traversal of src/isogeny.c and src/twisted_edwards.c
+    :param n: number of leaves
+    :param strategy: strategy of length n - 1
+    :return: maximum number of stored internal points
+    """
+    index, position, points, maximum = 0, 0, [], 0
+    for row in range(1, n):
+        while index < n - row:
+            points.append(index)
+            maximum = max(maximum, len(points))
+            index += strategy[position]
+            position += 1
+        index = points.pop()
+    assert (position == len(strategy))
+    return maximum
+
+
+def parameter(header: str, name: str):
+    match = re.search(rf'#define\s+{name}\s+(\d+)', header)
+    assert match, f'{name} not found'
+    return int(match.group(1))
+
+
+def measure(tests: pathlib.Path, iterations: int):
+    output = subprocess.run([str(tests), 'benchmarks/strategy', '--show-stderr', '--no-fork',
+                             '--param', 'iterations', str(iterations)],
+                            capture_output=True, text=True, check=True)
+    medians, title = {}, None
+    for line in output.stderr.splitlines():
+        match = re.search(r'(Strategy .+?) p\d+ with \d+ iterations', line)
+        if match:
+            title = match.group(1)
+        cycles = re.search(r'(\d+)\s+cycles \[median\]', line)
+        if cycles and title:
+            medians[title], title = float(cycles.group(1)), None
+    return medians
+
+
+def array(name: str, length: str, strategy: list):
+    rows = [', '.join(str(s) for s in strategy[i:i + 24]) for i in range(0, len(strategy), 24)]
+    body = ',\n        '.join(rows)
+    return f'static const unsigned int {name}[{length}] = {{\n        {body}\n}};\n'
+
+
+@click.command()
+@click.option('--prime', default=434, type=click.Choice([str(p) for p in PRIMES]), help='SIDH prime')
+@click.option('--build', default='build', help='Build folder containing tests/tests-sidh-sign-p<PRIME>')
+@click.option('--backend', default='c', type=click.Choice(['c', 'asm']), help='Field arithmetic of the build')
+@click.option('--iterations', default=200, help='Benchmark iterations per measured operation')
+def main(prime: str, build: str, backend: str, iterations: int):
+    root = pathlib.Path(__file__).resolve().parent.parent
+    header = (root / 'src' / f'P{prime}' / f'parameters_P{prime}.h').read_text()
+    n_alice = parameter(header, 'NUMBER_OF_ISOGENIES_ALICE')
+    n_bob = parameter(header, 'NUMBER_OF_ISOGENIES_BOB')
+
+    costs = measure(pathlib.Path(build) / 'tests' / f'tests-sidh-sign-p{prime}', iterations)
+    overhead = costs[TIMER_OVERHEAD]
+    # Evaluations are measured on pairs of points and the Pohlig-Hellman step over all the nine digits
+    p_alice = costs[ALICE_MULTIPLICATION] - overhead
+    q_alice = (costs[ALICE_EVALUATION] - overhead) / 2.0
+    p_bob = costs[BOB_MULTIPLICATION] - overhead
+    q_bob = (costs[BOB_EVALUATION] - overhead) / 2.0
+    p_ph = costs[POHLIG_HELLMAN_MULTIPLICATION] - overhead
+    q_ph = (costs[POHLIG_HELLMAN_EVALUATION] - overhead) / 9.0
+
+    strategy_alice, cost_alice = dpa(n_alice, p_alice, q_alice)
+    strategy_bob, cost_bob = dpa(n_bob, p_bob, q_bob)
+    strategy_ph, cost_ph = dpa(n_bob, p_ph, q_ph)
+    points_alice = maximum_internal_points(n_alice, strategy_alice)
+    # Shared by Bob's isogenies and the Pohlig-Hellman decomposition
+    points_bob = max(maximum_internal_points(n_bob, strategy_bob), maximum_internal_points(n_bob, strategy_ph))
+
+    guard = f'SIDH_POK_STRATEGIES_P{prime}_{backend.upper()}_H'
+    output = root / 'src' / f'P{prime}' / f'strategies_P{prime}_{backend}.h'
+    output.write_text(
+        f'// Generated by python_utils/strategy-tuner.py --prime {prime} --backend {backend}\n'
+        f'// Measured cycles: alice ({p_alice:.0f}, {q_alice:.0f}), bob ({p_bob:.0f}, {q_bob:.0f}), '
+        f'pohlig-hellman ({p_ph:.0f}, {q_ph:.0f})\n'
+        f'#ifndef {guard}\n'
+        f'#define {guard}\n\n'
+        f'#undef STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE\n'
+        f'#define STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE    {points_alice}\n'
+        f'#undef STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB\n'
+        f'#define STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB      {points_bob}\n\n'
+        + array('STRATEGY_ALICE', 'NUMBER_OF_ISOGENIES_ALICE - 1', strategy_alice) + '\n'
+        + array('STRATEGY_BOB', 'NUMBER_OF_ISOGENIES_BOB - 1', strategy_bob) + '\n'
+        + array('STRATEGY_POHLIG_HELLMAN', 'NUMBER_OF_ISOGENIES_BOB - 1', strategy_ph) + '\n'
+        f'#endif //{guard}\n')
+    click.echo(f'{output}')
+    click.echo(f'cost:\talice {cost_alice:.0f}\tbob {cost_bob:.0f}\tpohlig-hellman {cost_ph:.0f}')
+
+
+if __name__ == '__main__':
+    main()
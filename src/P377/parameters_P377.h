@@ -72,6 +72,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0xE44435C64BEFB9E9, 0x1077D183B5A4727B, 0x0019A2DF755CF268    // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         38, 26, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1,
         1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1,
@@ -81,6 +82,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4,
         2, 1, 1, 2, 1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -108,6 +110,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0x6232DFE1A85929F5, 0xC85434A71BF3CC30, 0x005DE7FAB257510D    // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         54, 31, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1,
         8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 15, 8, 4, 2,
@@ -117,7 +120,9 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         1, 9, 6, 4, 2, 1, 1, 2, 1, 1, 2, 2, 1, 1, 1, 4, 2, 1, 1,
         1, 2, 1, 1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         67, 30, 12, 5, 2, 1, 3, 1, 2, 1, 7, 3, 1, 2, 1, 4, 2, 1,
         2, 1, 1, 17, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 9, 5, 2,
@@ -127,6 +132,14 @@ static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] =
         2, 1, 13, 5, 2, 1, 1, 3, 1, 2, 1, 8, 3, 1, 2, 1, 5, 2, 1,
         3, 1, 2, 1
 };
+#endif
+
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P377_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P377_c.h"
+#endif
 
 #endif //SIDH_POK_PARAMETERS_P377_H
 
@@ -79,6 +79,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0x0000B87FC716C0C6  // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         48, 28, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1,
         1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4,
@@ -90,6 +91,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2,
         1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -123,6 +125,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0x000173FA910377D3  // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         66, 33, 17, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1,
         1, 4, 2, 1, 1, 1, 2, 1, 1, 8, 4, 2, 1,
@@ -136,14 +139,24 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1,
         4, 2, 1, 1, 2, 1, 1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         81, 33, 13, 5, 3, 1, 2, 1, 3, 1, 2, 1, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 20, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2,
         1, 12, 5, 2, 1, 3, 1, 2, 1, 7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1, 48, 20, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 12, 5,
         2, 1, 3, 1, 2, 1, 7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1, 28, 12, 5, 2, 1, 3, 1, 2, 1, 7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1,
         16, 7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1, 9, 4, 2, 1, 2, 1, 1, 5, 2, 1, 1, 3, 1, 2, 1
 };
+#endif
 
 
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P434_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P434_c.h"
+#endif
+
 #endif //SIDH_POK_PARAMETERS_P434_H
 
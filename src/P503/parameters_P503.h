@@ -70,6 +70,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0xA146FDCD0F2E2A58, 0x88B311E9CEAB6201, 0x37604CF5C7951757, 0x0006804071C74BF9    // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         61, 32, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1,
         1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4,
@@ -82,6 +83,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         1, 4, 2, 1, 1, 2, 1, 1, 5, 4, 2, 1,
         1, 2, 1, 1, 2, 1, 1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -109,6 +111,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0xE584E64C51604931, 0x1374F42AC8B0BBD7, 0x07D5BC37DFA41A5F, 0x00396CCFD61FD34C    // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         71, 38, 21, 13, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2,
         1, 1, 2, 1, 1, 5, 4, 2, 1, 1, 2, 1, 1,
@@ -124,7 +127,9 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2,
         1, 1, 2, 1, 1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         93, 38, 16, 7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1,
         9, 4, 2, 1, 2, 1, 1, 5, 2, 1, 1, 3, 1,
@@ -140,6 +145,14 @@ static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] =
         12, 5, 2, 1, 3, 1, 2, 1, 7, 3, 1, 2,
         1, 4, 2, 1, 2, 1, 1
 };
+#endif
+
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P503_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P503_c.h"
+#endif
 
 #endif //SIDH_POK_PARAMETERS_P503_H
 
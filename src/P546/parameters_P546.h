@@ -80,6 +80,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0x19AC9F7FC32A9F20, 0x04B599768492F2D5, 0x0000000248379BC7    // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         65, 33, 17, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 8, 4,
         2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2,
@@ -88,6 +89,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1,
         1, 2, 1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -121,6 +123,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0x00BA691C5F526CFF, 0x9B384D1CF1873823, 0x0000000152691238    // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         71, 43, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1,
         1, 3, 2, 1, 1, 1, 1, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1,
@@ -130,7 +133,9 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1,
         1, 4, 2, 1, 1, 2, 1, 1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         94, 45, 20, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 12, 5, 2, 1, 3, 1, 2, 1, 7, 3, 1, 2, 1,
         4, 2, 1, 2, 1, 1, 26, 11, 5, 2, 1, 3, 1, 2, 1, 6, 3, 1, 2, 1, 3, 2, 1, 2, 1, 15, 6, 3,
@@ -139,6 +144,14 @@ static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] =
         1, 2, 1, 34, 13, 5, 2, 1, 1, 3, 1, 2, 1, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 21, 8, 3,
         1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 13, 5, 2, 1, 3, 1, 2, 1, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1
 };
+#endif
+
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P546_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P546_c.h"
+#endif
 
 #endif //SIDH_POK_PARAMETERS_P546_H
 
@@ -79,6 +79,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0x25A1F9C5BBF1E683, 0x000000025AD7A11B    // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         67, 37, 21, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2,
         1, 1, 1, 1, 5, 3, 2, 1, 1, 1, 1, 2, 1,
@@ -93,6 +94,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1,
         2, 1, 1, 4, 2, 1, 1, 2, 1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -126,6 +128,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0x0CA38EB4AE5506B6, 0x00000001489DE1CD    // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         86, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2,
         1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 1,
@@ -144,7 +147,9 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2,
         1, 1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         112, 47, 20, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2,
         1, 12, 5, 2, 1, 3, 1, 2, 1, 7, 3, 1, 2,
@@ -163,6 +168,14 @@ static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] =
         2, 1, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1,
         2, 1
 };
+#endif
+
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P610_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P610_c.h"
+#endif
 
 #endif //SIDH_POK_PARAMETERS_P610_H
 
@@ -80,6 +80,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0x1FD965E5FB51C6F5, 0x86EA60BF172F4F54, 0x1568A2478263BE4    // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         72, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1,
         4, 2, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 12, 7, 4, 2, 1,
@@ -90,6 +91,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         1, 16, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1,
         4, 2, 1, 1, 2, 1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -123,6 +125,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0xEAED32068F11ACB9, 0xAFF1F42532675E47, 0x0078655255FA5626   // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         109, 58, 27, 12, 5, 2, 1, 1, 3, 1, 2, 1,
         7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1, 15, 7, 3, 1, 2, 1, 4, 2, 1, 2, 1, 1, 8, 4, 2,
@@ -134,7 +137,9 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         1, 1, 8, 4, 2, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 2, 1, 1, 4, 2,
         1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         129, 52, 21, 8, 3, 1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 13, 5, 2, 1, 3, 1, 2, 1, 8, 3,
         1, 2, 1, 5, 2, 1, 3, 1, 2, 1, 31, 13, 5, 2, 1, 3, 1, 2, 1, 8, 3, 1, 2, 1, 5, 2,
@@ -146,6 +151,14 @@ static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] =
         3, 1, 2, 1, 4, 2, 1, 2, 1, 1, 15, 5, 2, 1, 1, 3, 1, 2, 1, 8, 4, 2, 1, 2, 1, 1,
         5, 2, 1, 3, 1, 2, 1
 };
+#endif
+
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P697_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P697_c.h"
+#endif
 
 #endif //SIDH_POK_PARAMETERS_P697_H
 
@@ -79,6 +79,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_ALICE[6 * FIELD_64BITS_WORDS] = {
         0xC4C368A4632AFE72, 0x4B6EA85C9CCD5710, 0x7A12CAD582C7BC9A, 0x00001C7E240149BF    // XRA1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         80, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2,
         1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 1,
@@ -96,6 +97,7 @@ static const unsigned int STRATEGY_ALICE[NUMBER_OF_ISOGENIES_ALICE - 1] = {
         1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1,
         1, 4, 2, 1, 1, 2, 1, 1
 };
+#endif
 
 // ++++++++++++++++++++++++++++++++++++
 #define BOB 0
@@ -129,6 +131,7 @@ static const uint64_t PUBLIC_POINT_GENERATORS_BOB[6 * FIELD_64BITS_WORDS] = {
         0xF86A46A7506823F7, 0x8FE5523A7B7F1CFC, 0xFA3CFFA38372F67B, 0x0000692DCE85FFBD    // XRB1
 };
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         112, 63, 32, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2,
         1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1,
@@ -151,7 +154,9 @@ static const unsigned int STRATEGY_BOB[NUMBER_OF_ISOGENIES_BOB - 1] = {
         1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1,
         1
 };
+#endif
 
+#ifndef TUNED_STRATEGIES
 static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] = {
         144, 56, 22, 9, 5, 2, 1, 3, 1, 2, 1, 5, 2, 1,
         1, 3, 1, 2, 1, 13, 5, 2, 1, 1, 3, 1, 2,
@@ -174,6 +179,14 @@ static const unsigned int STRATEGY_POHLIG_HELLMAN[NUMBER_OF_ISOGENIES_BOB - 1] =
         1, 2, 1, 7, 3, 1, 2, 1, 4, 2, 1, 2,
         1, 1
 };
+#endif
+
+// Strategies tuned on the build machine by python_utils/strategy-tuner.py
+#if defined(TUNED_STRATEGIES) && defined(QUADRATIC_FIELD_ASM)
+#include "strategies_P751_asm.h"
+#elif defined(TUNED_STRATEGIES)
+#include "strategies_P751_c.h"
+#endif
 
 #endif //SIDH_POK_PARAMETERS_P751_H
 
@@ -0,0 +1,502 @@
+//
+// Local signing daemon over a UNIX domain socket, and its client library
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "daemon.h"
+
+typedef struct {
+    int fd;
+    atomic_int references;              // the server loop plus every request in flight
+    atomic_int in_flight;
+    atomic_ulong queued_bytes;          // payloads in flight, plus the one being received
+    pthread_mutex_t write_lock;
+    // Frame being received: the header, then the payload once the header is complete
+    uint8_t header[SIDH_DAEMON_HEADER_BYTES];
+    uint32_t header_received;
+    uint8_t *payload;
+    uint32_t payload_length;
+    uint32_t payload_received;
+} daemon_connection_t;
+
+typedef struct {
+    sidh_engine_job_t job;              // first member: the engine callback gets the request back from it
+    sidh_daemon_t *daemon;
+    daemon_connection_t *connection;
+    uint32_t id;
+    struct timespec received;
+    uint8_t *payload;
+    uint32_t length;
+    uint8_t signature[SIGNATURE_BYTES];
+} daemon_request_t;
+
+struct sidh_daemon {
+    sidh_engine_t *engine;
+    sidh_daemon_key_t *keys;
+    uint8_t number_of_keys;
+    int listener;
+    int wake[2];
+    pthread_t thread;
+    keccak_state state;
+    char socket_path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+    atomic_ulong queue_depth;
+    atomic_ulong completed;
+    atomic_ulong total_latency_us;
+    atomic_ulong maximum_latency_us;
+};
+
+static void store_u32(uint8_t *output, uint32_t input) {
+    for (int i = 0; i < 4; i++) { output[i] = (uint8_t) (input >> (8 * i)); }
+}
+
+static uint32_t load_u32(const uint8_t *input) {
+    uint32_t output = 0;
+    for (int i = 0; i < 4; i++) { output |= (uint32_t) input[i] << (8 * i); }
+    return output;
+}
+
+static void store_u64(uint8_t *output, uint64_t input) {
+    for (int i = 0; i < 8; i++) { output[i] = (uint8_t) (input >> (8 * i)); }
+}
+
+static uint64_t load_u64(const uint8_t *input) {
+    uint64_t output = 0;
+    for (int i = 0; i < 8; i++) { output |= (uint64_t) input[i] << (8 * i); }
+    return output;
+}
+
+static uint8_t send_all(int fd, const uint8_t *input, uint64_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, input, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) { continue; }
+        if (sent <= 0) { return EXIT_FAILURE; }
+        input += sent;
+        length -= (uint64_t) sent;
+    }
+    return EXIT_SUCCESS;
+}
+
+static uint8_t receive_all(int fd, uint8_t *output, uint64_t length) {
+    while (length > 0) {
+        ssize_t received = recv(fd, output, length, 0);
+        if (received < 0 && errno == EINTR) { continue; }
+        if (received <= 0) { return EXIT_FAILURE; }
+        output += received;
+        length -= (uint64_t) received;
+    }
+    return EXIT_SUCCESS;
+}
+
+static uint64_t elapsed_us(struct timespec start) {
+    struct timespec stop;
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    return (uint64_t) ((stop.tv_sec - start.tv_sec) * 1000000L + (stop.tv_nsec - start.tv_nsec) / 1000L);
+}
+
+// ++++++++++++++++++++ Server ++++++++++++++++++++
+
+static void connection_release(daemon_connection_t *connection) {
+    if (atomic_fetch_sub(&connection->references, 1) != 1) { return; }
+    close(connection->fd);
+    pthread_mutex_destroy(&connection->write_lock);
+    free(connection->payload);
+    free(connection);
+}
+
+// Backpressure: a connection at its limits is not read until some of its requests complete
+static uint8_t connection_is_full(daemon_connection_t *connection) {
+    return atomic_load(&connection->in_flight) >= SIDH_DAEMON_MAX_IN_FLIGHT ||
+           atomic_load(&connection->queued_bytes) >= SIDH_DAEMON_MAX_QUEUED_BYTES;
+}
+
+static void daemon_respond(daemon_connection_t *connection, uint8_t status, uint32_t id,
+                           const uint8_t *payload, uint32_t payload_length) {
+    uint8_t header[SIDH_DAEMON_HEADER_BYTES] = {0};
+
+    store_u32(header, payload_length);
+    header[4] = status;
+    store_u32(&header[8], id);
+
+    pthread_mutex_lock(&connection->write_lock);
+    if (send_all(connection->fd, header, sizeof(header)) == EXIT_SUCCESS && payload_length > 0) {
+        send_all(connection->fd, payload, payload_length);
+    }
+    pthread_mutex_unlock(&connection->write_lock);
+}
+
+static void request_free(daemon_request_t *request) {
+    atomic_fetch_sub(&request->connection->queued_bytes, request->length);
+    atomic_fetch_sub(&request->connection->in_flight, 1);
+    connection_release(request->connection);
+    free(request->payload);
+    free(request);
+}
+
+// Engine callback: the daemon owns the job from here on
+static void daemon_completed(sidh_engine_job_t *job, void *user_data) {
+    daemon_request_t *request = (daemon_request_t *) job;
+    sidh_daemon_t *daemon = (sidh_daemon_t *) user_data;
+    uint64_t latency = elapsed_us(request->received), maximum = atomic_load(&daemon->maximum_latency_us);
+
+    atomic_fetch_add(&daemon->completed, 1);
+    atomic_fetch_add(&daemon->total_latency_us, latency);
+    while (latency > maximum && !atomic_compare_exchange_weak(&daemon->maximum_latency_us, &maximum, latency)) {}
+    atomic_fetch_sub(&daemon->queue_depth, 1);
+
+    if (job->kind == SIDH_ENGINE_JOB_SIGN && job->result == EXIT_SUCCESS) {
+        daemon_respond(request->connection, EXIT_SUCCESS, request->id, request->signature, SIGNATURE_BYTES);
+    } else {
+        daemon_respond(request->connection, job->result, request->id, NULL, 0);
+    }
+    request_free(request);
+}
+
+// Hands a complete frame to the engine; the request takes over the payload buffer of the connection
+static void daemon_dispatch(sidh_daemon_t *daemon, daemon_connection_t *connection) {
+    uint8_t opcode = connection->header[4], key = connection->header[5];
+    uint32_t length = connection->payload_length, id = load_u32(&connection->header[8]);
+    daemon_request_t *request;
+
+    request = calloc(1, sizeof(daemon_request_t));
+    if (request == NULL) {
+        atomic_fetch_sub(&connection->queued_bytes, length);
+        free(connection->payload);
+        connection->payload = NULL;
+        daemon_respond(connection, EXIT_FAILURE, id, NULL, 0);
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &request->received);
+    request->daemon = daemon;
+    request->connection = connection;
+    request->id = id;
+    request->payload = connection->payload;
+    request->length = length;
+    connection->payload = NULL;
+    atomic_fetch_add(&connection->references, 1);
+    atomic_fetch_add(&connection->in_flight, 1);
+
+    sidh_engine_job_t *job = &request->job;
+    job->priority = SIDH_ENGINE_PRIORITY_NORMAL;
+    job->callback = daemon_completed;
+    job->user_data = daemon;
+    job->signature = request->signature;
+    if (opcode == SIDH_DAEMON_OPCODE_SIGN && key < daemon->number_of_keys) {
+        job->kind = SIDH_ENGINE_JOB_SIGN;
+        job->message = request->payload;
+        job->message_length = length;
+        job->private_key = daemon->keys[key].private_key;
+        job->public_key = daemon->keys[key].public_key;
+    } else if (opcode == SIDH_DAEMON_OPCODE_VERIFY && length > PUBLIC_KEY_BYTES + SIGNATURE_BYTES) {
+        job->kind = SIDH_ENGINE_JOB_VERIFY;
+        job->public_key = request->payload;
+        memcpy(request->signature, &request->payload[PUBLIC_KEY_BYTES], SIGNATURE_BYTES);
+        job->message = &request->payload[PUBLIC_KEY_BYTES + SIGNATURE_BYTES];
+        job->message_length = length - PUBLIC_KEY_BYTES - SIGNATURE_BYTES;
+    } else if (opcode == SIDH_DAEMON_OPCODE_STATS) {
+        sidh_daemon_stats_t stats;
+        uint8_t payload[4 * sizeof(uint64_t)];
+        sidh_daemon_get_stats(daemon, &stats);
+        store_u64(payload, stats.queue_depth);
+        store_u64(&payload[8], stats.completed);
+        store_u64(&payload[16], stats.average_latency_us);
+        store_u64(&payload[24], stats.maximum_latency_us);
+        daemon_respond(connection, EXIT_SUCCESS, id, payload, sizeof(payload));
+        request_free(request);
+        return;
+    } else {
+        daemon_respond(connection, EXIT_FAILURE, id, NULL, 0);
+        request_free(request);
+        return;
+    }
+
+    // Concurrent requests share the engine, so their rounds are scheduled as one batch of work
+    atomic_fetch_add(&daemon->queue_depth, 1);
+    if (sidh_engine_submit(daemon->engine, job, &daemon->state) == EXIT_FAILURE) {
+        atomic_fetch_sub(&daemon->queue_depth, 1);
+        daemon_respond(connection, EXIT_FAILURE, id, NULL, 0);
+        request_free(request);
+    }
+}
+
+// Reads whatever the socket holds without blocking, dispatching every frame it completes. It fails only when the
+// connection must be closed
+static uint8_t daemon_read_requests(sidh_daemon_t *daemon, daemon_connection_t *connection) {
+    ssize_t received;
+
+    while (!connection_is_full(connection)) {
+        if (connection->header_received < SIDH_DAEMON_HEADER_BYTES) {
+            received = recv(connection->fd, &connection->header[connection->header_received],
+                            SIDH_DAEMON_HEADER_BYTES - connection->header_received, MSG_DONTWAIT);
+        } else {
+            received = recv(connection->fd, &connection->payload[connection->payload_received],
+                            connection->payload_length - connection->payload_received, MSG_DONTWAIT);
+        }
+        if (received < 0 && errno == EINTR) { continue; }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { return EXIT_SUCCESS; }
+        if (received <= 0) { return EXIT_FAILURE; }
+
+        if (connection->header_received < SIDH_DAEMON_HEADER_BYTES) {
+            connection->header_received += (uint32_t) received;
+            if (connection->header_received < SIDH_DAEMON_HEADER_BYTES) { continue; }
+            connection->payload_length = load_u32(connection->header);
+            connection->payload_received = 0;
+            if (connection->payload_length > SIDH_DAEMON_MAX_PAYLOAD_BYTES) { return EXIT_FAILURE; }
+            connection->payload = malloc(connection->payload_length > 0 ? connection->payload_length : 1);
+            if (connection->payload == NULL) { return EXIT_FAILURE; }
+            atomic_fetch_add(&connection->queued_bytes, connection->payload_length);
+        } else {
+            connection->payload_received += (uint32_t) received;
+        }
+        if (connection->payload_received == connection->payload_length) {
+            connection->header_received = 0;
+            daemon_dispatch(daemon, connection);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+static void *daemon_loop(void *argument) {
+    sidh_daemon_t *daemon = (sidh_daemon_t *) argument;
+    daemon_connection_t *connections[SIDH_DAEMON_MAX_CONNECTIONS];
+    struct pollfd fds[2 + SIDH_DAEMON_MAX_CONNECTIONS];
+    struct timeval send_timeout = {SIDH_DAEMON_SEND_TIMEOUT_MS / 1000, (SIDH_DAEMON_SEND_TIMEOUT_MS % 1000) * 1000};
+    int i, timeout, number_of_connections = 0;
+
+    for (;;) {
+        fds[0].fd = daemon->listener;
+        fds[0].events = POLLIN;
+        fds[1].fd = daemon->wake[0];
+        fds[1].events = POLLIN;
+        // Full connections are polled again shortly, once their requests had time to complete
+        timeout = -1;
+        for (i = 0; i < number_of_connections; i++) {
+            fds[2 + i].fd = connections[i]->fd;
+            fds[2 + i].events = POLLIN;
+            if (connection_is_full(connections[i])) {
+                fds[2 + i].events = 0;
+                timeout = 10;
+            }
+        }
+        if (poll(fds, 2 + number_of_connections, timeout) < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+        if (fds[1].revents) { break; }
+
+        for (i = number_of_connections - 1; i >= 0; i--) {
+            if (!(fds[2 + i].revents & (POLLIN | POLLHUP | POLLERR)) && timeout < 0) { continue; }
+            if (daemon_read_requests(daemon, connections[i]) == EXIT_FAILURE) {
+                connection_release(connections[i]);
+                connections[i] = connections[--number_of_connections];
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(daemon->listener, NULL, NULL);
+            if (fd < 0) { continue; }
+            if (number_of_connections == SIDH_DAEMON_MAX_CONNECTIONS) {
+                close(fd);
+                continue;
+            }
+            daemon_connection_t *connection = calloc(1, sizeof(daemon_connection_t));
+            if (connection == NULL) {
+                close(fd);
+                continue;
+            }
+            // Reads never block the loop; writes from the loop or the engine workers give up on stalled clients
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+            connection->fd = fd;
+            atomic_init(&connection->references, 1);
+            atomic_init(&connection->in_flight, 0);
+            atomic_init(&connection->queued_bytes, 0);
+            pthread_mutex_init(&connection->write_lock, NULL);
+            connections[number_of_connections++] = connection;
+        }
+    }
+
+    for (i = 0; i < number_of_connections; i++) { connection_release(connections[i]); }
+    return NULL;
+}
+
+sidh_daemon_t *sidh_daemon_start(const char *socket_path,
+                                 const sidh_daemon_key_t *keys,
+                                 uint8_t number_of_keys,
+                                 unsigned int number_of_threads) {
+    struct sockaddr_un address = {0};
+    uint8_t seed[SIDH_ENGINE_SEED_BYTES];
+    sidh_daemon_t *daemon;
+    int random_fd;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path)) { return NULL; }
+    daemon = calloc(1, sizeof(sidh_daemon_t));
+    if (daemon == NULL) { return NULL; }
+    daemon->listener = -1;
+    daemon->wake[0] = daemon->wake[1] = -1;
+
+    // Signing randomness
+    random_fd = open("/dev/urandom", O_RDONLY);
+    if (random_fd < 0 || read(random_fd, seed, sizeof(seed)) != (ssize_t) sizeof(seed)) {
+        if (random_fd >= 0) { close(random_fd); }
+        free(daemon);
+        return NULL;
+    }
+    close(random_fd);
+    shake256_init(&daemon->state);
+    shake256_absorb(&daemon->state, seed, sizeof(seed));
+    shake256_finalize(&daemon->state);
+
+    daemon->keys = malloc(sizeof(sidh_daemon_key_t) * (number_of_keys > 0 ? number_of_keys : 1));
+    if (daemon->keys == NULL) { goto fail; }
+    memcpy(daemon->keys, keys, sizeof(sidh_daemon_key_t) * number_of_keys);
+    daemon->number_of_keys = number_of_keys;
+
+    daemon->engine = sidh_engine_create(number_of_threads);
+    if (daemon->engine == NULL || pipe(daemon->wake) != 0) { goto fail; }
+
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    strcpy(daemon->socket_path, socket_path);
+    unlink(socket_path);
+    daemon->listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (daemon->listener < 0 ||
+        bind(daemon->listener, (struct sockaddr *) &address, sizeof(address)) != 0 ||
+        chmod(socket_path, S_IRUSR | S_IWUSR) != 0 ||
+        listen(daemon->listener, SIDH_DAEMON_MAX_CONNECTIONS) != 0) { goto fail; }
+
+    if (pthread_create(&daemon->thread, NULL, daemon_loop, daemon) != 0) { goto fail; }
+    return daemon;
+
+    fail:
+    if (daemon->listener >= 0) {
+        close(daemon->listener);
+        unlink(socket_path);
+    }
+    if (daemon->wake[0] >= 0) {
+        close(daemon->wake[0]);
+        close(daemon->wake[1]);
+    }
+    sidh_engine_destroy(daemon->engine);
+    free(daemon->keys);
+    free(daemon);
+    return NULL;
+}
+
+void sidh_daemon_stop(sidh_daemon_t *daemon) {
+    uint8_t byte = 0;
+
+    if (daemon == NULL) { return; }
+    while (write(daemon->wake[1], &byte, 1) < 0 && errno == EINTR) {}
+    pthread_join(daemon->thread, NULL);
+    // Answers the requests in flight
+    sidh_engine_destroy(daemon->engine);
+
+    close(daemon->listener);
+    unlink(daemon->socket_path);
+    close(daemon->wake[0]);
+    close(daemon->wake[1]);
+    memset(daemon->keys, 0, sizeof(sidh_daemon_key_t) * daemon->number_of_keys);
+    free(daemon->keys);
+    free(daemon);
+}
+
+void sidh_daemon_get_stats(sidh_daemon_t *daemon, sidh_daemon_stats_t *stats) {
+    stats->queue_depth = atomic_load(&daemon->queue_depth);
+    stats->completed = atomic_load(&daemon->completed);
+    stats->average_latency_us = (stats->completed > 0) ? atomic_load(&daemon->total_latency_us) / stats->completed : 0;
+    stats->maximum_latency_us = atomic_load(&daemon->maximum_latency_us);
+}
+
+// ++++++++++++++++++++ Client ++++++++++++++++++++
+
+static atomic_uint client_request_id;
+
+int sidh_daemon_connect(const char *socket_path) {
+    struct sockaddr_un address = {0};
+    int fd;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path)) { return -1; }
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { return -1; }
+    if (connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void sidh_daemon_disconnect(int connection) {
+    close(connection);
+}
+
+// One synchronous round trip: the request payload is the concatenation of up to three parts
+static uint8_t client_request(int connection, uint8_t opcode, uint8_t key,
+                              const uint8_t *parts[3], const uint64_t part_lengths[3],
+                              uint8_t *response, uint32_t response_length) {
+    uint8_t header[SIDH_DAEMON_HEADER_BYTES] = {0};
+    uint64_t length = part_lengths[0] + part_lengths[1] + part_lengths[2];
+    uint32_t id = atomic_fetch_add(&client_request_id, 1);
+
+    if (length > SIDH_DAEMON_MAX_PAYLOAD_BYTES) { return EXIT_FAILURE; }
+    store_u32(header, (uint32_t) length);
+    header[4] = opcode;
+    header[5] = key;
+    store_u32(&header[8], id);
+    if (send_all(connection, header, sizeof(header)) == EXIT_FAILURE) { return EXIT_FAILURE; }
+    for (int i = 0; i < 3; i++) {
+        if (part_lengths[i] > 0 && send_all(connection, parts[i], part_lengths[i]) == EXIT_FAILURE) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (receive_all(connection, header, sizeof(header)) == EXIT_FAILURE) { return EXIT_FAILURE; }
+    if (load_u32(&header[8]) != id || header[4] != EXIT_SUCCESS) { return EXIT_FAILURE; }
+    if (load_u32(header) != response_length) { return EXIT_FAILURE; }
+    return receive_all(connection, response, response_length);
+}
+
+uint8_t sidh_daemon_sign(int connection,
+                         uint8_t key,
+                         uint8_t signature[SIGNATURE_BYTES],
+                         const uint8_t *message,
+                         uint64_t message_length) {
+    const uint8_t *parts[3] = {message, NULL, NULL};
+    const uint64_t part_lengths[3] = {message_length, 0, 0};
+    return client_request(connection, SIDH_DAEMON_OPCODE_SIGN, key, parts, part_lengths, signature, SIGNATURE_BYTES);
+}
+
+uint8_t sidh_daemon_verify(int connection,
+                           const uint8_t signature[SIGNATURE_BYTES],
+                           const uint8_t *message,
+                           uint64_t message_length,
+                           const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    const uint8_t *parts[3] = {public_key, signature, message};
+    const uint64_t part_lengths[3] = {PUBLIC_KEY_BYTES, SIGNATURE_BYTES, message_length};
+    return client_request(connection, SIDH_DAEMON_OPCODE_VERIFY, 0, parts, part_lengths, NULL, 0);
+}
+
+uint8_t sidh_daemon_stats(int connection, sidh_daemon_stats_t *stats) {
+    const uint8_t *parts[3] = {NULL, NULL, NULL};
+    const uint64_t part_lengths[3] = {0, 0, 0};
+    uint8_t payload[4 * sizeof(uint64_t)];
+
+    if (client_request(connection, SIDH_DAEMON_OPCODE_STATS, 0, parts, part_lengths, payload, sizeof(payload)) ==
+        EXIT_FAILURE) { return EXIT_FAILURE; }
+    stats->queue_depth = load_u64(payload);
+    stats->completed = load_u64(&payload[8]);
+    stats->average_latency_us = load_u64(&payload[16]);
+    stats->maximum_latency_us = load_u64(&payload[24]);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+//
+// Local signing daemon over a UNIX domain socket, and its client library
+//
+
+#ifndef SIDH_POK_DAEMON_H
+#define SIDH_POK_DAEMON_H
+
+#include "engine.h"
+
+// Framing (little-endian): request  = length:u32 || opcode:u8 || key:u8 || reserved:u16 || id:u32 || payload
+//                          response = length:u32 || status:u8 || reserved:u8[3] || id:u32 || payload
+// where length counts the payload bytes only
+#define SIDH_DAEMON_HEADER_BYTES        12
+#define SIDH_DAEMON_MAX_PAYLOAD_BYTES   (1UL << 24)
+#define SIDH_DAEMON_MAX_CONNECTIONS     64
+#define SIDH_DAEMON_MAX_IN_FLIGHT       16          // requests per connection; further frames wait in the socket
+#define SIDH_DAEMON_MAX_QUEUED_BYTES    (1UL << 25) // payload bytes per connection, in flight or being received
+#define SIDH_DAEMON_SEND_TIMEOUT_MS     5000        // responses to clients that stop reading are dropped
+
+#define SIDH_DAEMON_OPCODE_SIGN         0   // payload: message; response: signature
+#define SIDH_DAEMON_OPCODE_VERIFY       1   // payload: public key || signature || message
+#define SIDH_DAEMON_OPCODE_STATS        2   // response: sidh_daemon_stats_t as 4 u64
+
+typedef struct {
+    uint8_t private_key[SECRET_KEY_BYTES];
+    uint8_t public_key[PUBLIC_KEY_BYTES];
+} sidh_daemon_key_t;
+
+typedef struct {
+    uint64_t queue_depth;               // requests submitted and not yet answered
+    uint64_t completed;
+    uint64_t average_latency_us;        // from frame received to response sent
+    uint64_t maximum_latency_us;
+} sidh_daemon_stats_t;
+
+typedef struct sidh_daemon sidh_daemon_t;
+
+// Keys are copied; signing requests select them by index. Zero threads means one per online core.
+// The socket is created with mode 0600, so that only the daemon user can request signatures
+sidh_daemon_t *sidh_daemon_start(const char *socket_path,
+                                 const sidh_daemon_key_t *keys,
+                                 uint8_t number_of_keys,
+                                 unsigned int number_of_threads);
+
+// Stops accepting requests and waits for the pending ones
+void sidh_daemon_stop(sidh_daemon_t *daemon);
+
+void sidh_daemon_get_stats(sidh_daemon_t *daemon, sidh_daemon_stats_t *stats);
+
+// ****************** CLIENT *******************//
+
+int sidh_daemon_connect(const char *socket_path);
+
+void sidh_daemon_disconnect(int connection);
+
+uint8_t sidh_daemon_sign(int connection,
+                         uint8_t key,
+                         uint8_t signature[SIGNATURE_BYTES],
+                         const uint8_t *message,
+                         uint64_t message_length);
+
+uint8_t sidh_daemon_verify(int connection,
+                           const uint8_t signature[SIGNATURE_BYTES],
+                           const uint8_t *message,
+                           uint64_t message_length,
+                           const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+uint8_t sidh_daemon_stats(int connection, sidh_daemon_stats_t *stats);
+
+#endif //SIDH_POK_DAEMON_H
@@ -0,0 +1,234 @@
+//
+// Message digest of the signature statement: flat SHAKE256, or a SHAKE256 tree for very large messages
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "digest.h"
+#include "fips202x4.h"
+
+typedef struct {
+    uint8_t *chaining_values;
+    const uint8_t *message;
+    uint64_t message_length;
+    uint64_t first_leaf;
+    uint64_t last_leaf;
+} tree_digest_share_t;
+
+static void store_u64(uint8_t output[8], uint64_t input) {
+    for (int i = 0; i < 8; i++) { output[i] = (uint8_t) (input >> (8 * i)); }
+}
+
+static void tree_digest_root_init(keccak_state *root) {
+    uint8_t leaf_size[8];
+
+    store_u64(leaf_size, TREE_DIGEST_LEAF_BYTES);
+    shake256_init(root);
+    shake256_absorb(root, leaf_size, sizeof(leaf_size));
+}
+
+static void tree_digest_root_final(uint8_t digest[MESSAGE_DIGEST_BYTES], keccak_state *root, uint64_t length) {
+    uint8_t message_length[8];
+
+    store_u64(message_length, length);
+    shake256_absorb(root, message_length, sizeof(message_length));
+    shake256_finalize(root);
+    shake256_squeeze(digest, MESSAGE_DIGEST_BYTES, root);
+}
+
+// Full leaves four at a time on the SIMD lanes, then the remaining (possibly partial) leaves one by one
+static void tree_digest_leaves(uint8_t *chaining_values, const uint8_t *leaves, uint64_t length) {
+    uint64_t leaf_length;
+
+    while (length >= 4 * TREE_DIGEST_LEAF_BYTES) {
+        shake256x4(chaining_values,
+                   &chaining_values[TREE_DIGEST_CHAINING_BYTES],
+                   &chaining_values[2 * TREE_DIGEST_CHAINING_BYTES],
+                   &chaining_values[3 * TREE_DIGEST_CHAINING_BYTES],
+                   TREE_DIGEST_CHAINING_BYTES,
+                   leaves,
+                   &leaves[TREE_DIGEST_LEAF_BYTES],
+                   &leaves[2 * TREE_DIGEST_LEAF_BYTES],
+                   &leaves[3 * TREE_DIGEST_LEAF_BYTES],
+                   TREE_DIGEST_LEAF_BYTES);
+        chaining_values += 4 * TREE_DIGEST_CHAINING_BYTES;
+        leaves += 4 * TREE_DIGEST_LEAF_BYTES;
+        length -= 4 * TREE_DIGEST_LEAF_BYTES;
+    }
+    while (length > 0) {
+        leaf_length = (length < TREE_DIGEST_LEAF_BYTES) ? length : TREE_DIGEST_LEAF_BYTES;
+        shake256(chaining_values, TREE_DIGEST_CHAINING_BYTES, leaves, leaf_length);
+        chaining_values += TREE_DIGEST_CHAINING_BYTES;
+        leaves += leaf_length;
+        length -= leaf_length;
+    }
+}
+
+void sidh_tree_digest_init(sidh_digest_state_t *state) {
+    tree_digest_root_init(&state->root);
+    state->leaf_bytes = 0;
+    state->length = 0;
+}
+
+void sidh_tree_digest_update(sidh_digest_state_t *state, const uint8_t *input, uint64_t input_length) {
+    uint8_t chaining_values[4 * TREE_DIGEST_CHAINING_BYTES];
+    uint64_t length;
+
+    state->length += input_length;
+
+    // Complete the buffered leaf first
+    if (state->leaf_bytes > 0) {
+        length = TREE_DIGEST_LEAF_BYTES - state->leaf_bytes;
+        length = (input_length < length) ? input_length : length;
+        shake256_absorb(&state->leaf, input, length);
+        state->leaf_bytes += length;
+        input += length;
+        input_length -= length;
+        if (state->leaf_bytes < TREE_DIGEST_LEAF_BYTES) { return; }
+
+        shake256_finalize(&state->leaf);
+        shake256_squeeze(chaining_values, TREE_DIGEST_CHAINING_BYTES, &state->leaf);
+        shake256_absorb(&state->root, chaining_values, TREE_DIGEST_CHAINING_BYTES);
+        state->leaf_bytes = 0;
+    }
+
+    // Whole leaves straight from the input
+    while (input_length >= TREE_DIGEST_LEAF_BYTES) {
+        length = (input_length >= 4 * TREE_DIGEST_LEAF_BYTES) ? 4 * TREE_DIGEST_LEAF_BYTES : TREE_DIGEST_LEAF_BYTES;
+        tree_digest_leaves(chaining_values, input, length);
+        shake256_absorb(&state->root, chaining_values, (length / TREE_DIGEST_LEAF_BYTES) * TREE_DIGEST_CHAINING_BYTES);
+        input += length;
+        input_length -= length;
+    }
+
+    if (input_length > 0) {
+        shake256_init(&state->leaf);
+        shake256_absorb(&state->leaf, input, input_length);
+        state->leaf_bytes = input_length;
+    }
+}
+
+void sidh_tree_digest_final(uint8_t digest[MESSAGE_DIGEST_BYTES], sidh_digest_state_t *state) {
+    uint8_t chaining_value[TREE_DIGEST_CHAINING_BYTES];
+
+    if (state->leaf_bytes > 0) {
+        shake256_finalize(&state->leaf);
+        shake256_squeeze(chaining_value, TREE_DIGEST_CHAINING_BYTES, &state->leaf);
+        shake256_absorb(&state->root, chaining_value, TREE_DIGEST_CHAINING_BYTES);
+    }
+    tree_digest_root_final(digest, &state->root, state->length);
+}
+
+static void *tree_digest_thread(void *argument) {
+    tree_digest_share_t *share = (tree_digest_share_t *) argument;
+    uint64_t begin = share->first_leaf * TREE_DIGEST_LEAF_BYTES;
+    uint64_t end = share->last_leaf * TREE_DIGEST_LEAF_BYTES;
+
+    if (share->first_leaf >= share->last_leaf) { return NULL; }
+    end =(end < share->message_length) ? end : share->message_length;
+    tree_digest_leaves(&share->chaining_values[share->first_leaf * TREE_DIGEST_CHAINING_BYTES],
+                       &share->message[begin], end - begin);
+    return NULL;
+}
+
+void sidh_tree_digest(uint8_t digest[MESSAGE_DIGEST_BYTES],
+                      const uint8_t *message,
+                      uint64_t message_length,
+                      unsigned int number_of_threads) {
+    uint64_t leaves = (message_length + TREE_DIGEST_LEAF_BYTES - 1) / TREE_DIGEST_LEAF_BYTES;
+    uint64_t maximum_threads = leaves / TREE_DIGEST_THREAD_LEAVES;
+    tree_digest_share_t *shares;
+    pthread_t *threads;
+    uint8_t *chaining_values;
+    sidh_digest_state_t state;
+    unsigned int i, started;
+
+    if (number_of_threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        number_of_threads = (cores > 0) ? (unsigned int) cores : 1;
+        if (number_of_threads > maximum_threads) { number_of_threads = (unsigned int) maximum_threads; }
+    }
+    if (number_of_threads > leaves) { number_of_threads = (unsigned int) leaves; }
+
+    chaining_values = (number_of_threads > 1) ? malloc(leaves * TREE_DIGEST_CHAINING_BYTES) : NULL;
+    shares = (chaining_values != NULL) ? malloc(number_of_threads * sizeof(tree_digest_share_t)) : NULL;
+    threads = (shares != NULL) ? malloc(number_of_threads * sizeof(pthread_t)) : NULL;
+    if (threads == NULL) {
+        // Small messages, or out of memory: the streaming digest needs no buffer
+        free(shares);
+        free(chaining_values);
+        sidh_tree_digest_init(&state);
+        sidh_tree_digest_update(&state, message, message_length);
+        sidh_tree_digest_final(digest, &state);
+        return;
+    }
+
+    // Contiguous shares rounded to multiples of four leaves, so that only the last share has a partial group
+    for (i = 0; i < number_of_threads; i++) {
+        shares[i].chaining_values = chaining_values;
+        shares[i].message = message;
+        shares[i].message_length = message_length;
+        shares[i].first_leaf = (i == 0) ? 0 : shares[i - 1].last_leaf;
+        shares[i].last_leaf = (((leaves * (i + 1)) / number_of_threads) + 3) & ~(uint64_t) 3;
+        if (shares[i].last_leaf > leaves || i == number_of_threads - 1) { shares[i].last_leaf = leaves; }
+    }
+
+    // The calling thread takes the first share; a thread that fails to start has its share run here too
+    for (started = 1; started < number_of_threads; started++) {
+        if (pthread_create(&threads[started], NULL, tree_digest_thread, &shares[started]) != 0) { break; }
+    }
+    tree_digest_thread(&shares[0]);
+    for (i = started; i < number_of_threads; i++) { tree_digest_thread(&shares[i]); }
+    for (i = 1; i < started; i++) { pthread_join(threads[i], NULL); }
+
+    tree_digest_root_init(&state.root);
+    shake256_absorb(&state.root, chaining_values, leaves * TREE_DIGEST_CHAINING_BYTES);
+    tree_digest_root_final(digest, &state.root, message_length);
+
+    free(threads);
+    free(shares);
+    free(chaining_values);
+}
+
+void sidh_message_digest_init(sidh_digest_state_t *state) {
+#ifdef TREE_DIGEST
+    sidh_tree_digest_init(state);
+#else
+    shake256_init(&state->leaf);
+    state->length = 0;
+#endif
+}
+
+void sidh_message_digest_update(sidh_digest_state_t *state, const uint8_t *input, uint64_t input_length) {
+#ifdef TREE_DIGEST
+    sidh_tree_digest_update(state, input, input_length);
+#else
+    shake256_absorb(&state->leaf, input, input_length);
+    state->length += input_length;
+#endif
+}
+
+uint8_t sidh_message_digest_final(uint8_t digest[MESSAGE_DIGEST_BYTES], sidh_digest_state_t *state) {
+    // Empty messages are refused, as by sidh_signature_sign and sidh_signature_verify
+    if (state->length == 0) {
+        memset(digest, 0, MESSAGE_DIGEST_BYTES);
+        return EXIT_FAILURE;
+    }
+#ifdef TREE_DIGEST
+    sidh_tree_digest_final(digest, state);
+#else
+    shake256_finalize(&state->leaf);
+    shake256_squeeze(digest, MESSAGE_DIGEST_BYTES, &state->leaf);
+#endif
+    return EXIT_SUCCESS;
+}
+
+void sidh_message_digest(uint8_t digest[MESSAGE_DIGEST_BYTES], const uint8_t *message, uint64_t message_length) {
+#ifdef TREE_DIGEST
+    sidh_tree_digest(digest, message, message_length, 0);
+#else
+    shake256(digest, MESSAGE_DIGEST_BYTES, message, message_length);
+#endif
+}
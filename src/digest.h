@@ -0,0 +1,50 @@
+//
+// Message digest of the signature statement: flat SHAKE256, or a SHAKE256 tree for very large messages
+//
+
+#ifndef SIDH_POK_DIGEST_H
+#define SIDH_POK_DIGEST_H
+
+#include <stdint.h>
+#include "fips202.h"
+#include "parameters.h"
+
+#define MESSAGE_DIGEST_BYTES        (SECURITY_BITS / 8)
+
+// Tree digest, in the spirit of ParallelHash: leaves of TREE_DIGEST_LEAF_BYTES are hashed independently into
+// chaining values, and the root is SHAKE256(leaf size || chaining values || message length), sizes as 64-bit LE
+#define TREE_DIGEST_LEAF_BYTES      8192
+#define TREE_DIGEST_CHAINING_BYTES  (SECURITY_BITS / 4)
+#define TREE_DIGEST_THREAD_LEAVES   128     // smallest share of leaves worth a thread
+
+typedef struct {
+    keccak_state root;
+    keccak_state leaf;                  // current leaf, or the whole message for the flat digest
+    uint64_t leaf_bytes;
+    uint64_t length;
+} sidh_digest_state_t;
+
+void sidh_tree_digest_init(sidh_digest_state_t *state);
+
+void sidh_tree_digest_update(sidh_digest_state_t *state, const uint8_t *input, uint64_t input_length);
+
+void sidh_tree_digest_final(uint8_t digest[MESSAGE_DIGEST_BYTES], sidh_digest_state_t *state);
+
+// Leaves are spread over the threads (zero means one per online core, fewer for small messages),
+// and over the SIMD lanes of shake256x4 within each thread
+void sidh_tree_digest(uint8_t digest[MESSAGE_DIGEST_BYTES],
+                      const uint8_t *message,
+                      uint64_t message_length,
+                      unsigned int number_of_threads);
+
+// Digest used by the signature scheme: the tree digest when built with TREE_DIGEST, else SHAKE256(message)
+void sidh_message_digest_init(sidh_digest_state_t *state);
+
+void sidh_message_digest_update(sidh_digest_state_t *state, const uint8_t *input, uint64_t input_length);
+
+// Fails on an empty stream (the digest is then zeroed): empty messages are not signed
+uint8_t sidh_message_digest_final(uint8_t digest[MESSAGE_DIGEST_BYTES], sidh_digest_state_t *state);
+
+void sidh_message_digest(uint8_t digest[MESSAGE_DIGEST_BYTES], const uint8_t *message, uint64_t message_length);
+
+#endif //SIDH_POK_DIGEST_H
@@ -9,6 +9,17 @@
 
 #include "utilities.h"
 
+void scalar_power_of_three(scalar_t output, int input_e) {
+    scalar_t t;
+    memset(output, 0, sizeof(scalar_t));
+    output[0] = 1;
+    for (int i = 0; i < input_e; i++) {
+        memcpy(t, output, sizeof(scalar_t));
+        multiprecision_shift_to_left(output, SUBGROUP_ORDER_64BITS_WORDS);
+        multiprecision_addition(output, output, t, SUBGROUP_ORDER_64BITS_WORDS);
+    }
+}
+
 void x_only_point_copy(x_only_point_t *output, x_only_point_t input) {
     quadratic_field_copy(&output->X, input.X);
     quadratic_field_copy(&output->Z, input.Z);
@@ -137,6 +148,24 @@ void x_only_three_point_ladder(x_only_point_t *output_P_plus_kQ,
                                const scalar_t input_k,
                                int input_bits_of_k,
                                quadratic_field_element_t input_A) {
+    x_only_point_t P, Q, P_minus_Q;
+
+    quadratic_field_copy(&P.X, input_P);
+    quadratic_field_set_to_one(&P.Z);
+    quadratic_field_copy(&Q.X, input_Q);
+    quadratic_field_set_to_one(&Q.Z);
+    quadratic_field_copy(&P_minus_Q.X, input_P_minus_Q);
+    quadratic_field_set_to_one(&P_minus_Q.Z);
+    x_only_three_point_ladder_projective(output_P_plus_kQ, P, Q, P_minus_Q, input_k, input_bits_of_k, input_A);
+}
+
+void x_only_three_point_ladder_projective(x_only_point_t *output_P_plus_kQ,
+                                          x_only_point_t input_P,
+                                          x_only_point_t input_Q,
+                                          x_only_point_t input_P_minus_Q,
+                                          const scalar_t input_k,
+                                          int input_bits_of_k,
+                                          quadratic_field_element_t input_A) {
     x_only_point_t R0 = {0}, R2 = {0};
     quadratic_field_element_t quarter_of_A_plus_2 = {0};
     uint64_t mask;
@@ -151,12 +180,9 @@ void x_only_three_point_ladder(x_only_point_t *output_P_plus_kQ,
     quadratic_field_divide_by_2(&quarter_of_A_plus_2, quarter_of_A_plus_2);
 
     // Initializing points
-    quadratic_field_copy(&R0.X, input_Q);
-    quadratic_field_set_to_one(&R0.Z);
-    quadratic_field_copy(&R2.X, input_P_minus_Q);
-    quadratic_field_set_to_one(&R2.Z);
-    quadratic_field_copy(&output_P_plus_kQ->X, input_P);
-    quadratic_field_set_to_one(&output_P_plus_kQ->Z);
+    x_only_point_copy(&R0, input_Q);
+    x_only_point_copy(&R2, input_P_minus_Q);
+    x_only_point_copy(output_P_plus_kQ, input_P);
 
     // Main loop
     for (i = 0; i < input_bits_of_k; i++) {
@@ -176,6 +202,106 @@ void x_only_three_point_ladder(x_only_point_t *output_P_plus_kQ,
     x_only_point_swap(output_P_plus_kQ, &R2, mask);
 }
 
+// Affine x([2ⁱ]Q), i = 0 .. bits - 1, with one inversion: each entry first holds (X·(Z₀⋯Zᵢ₋₁), Zᵢ)
+void x_only_fixed_base_table(x_only_fixed_base_t *output_table,
+                             quadratic_field_element_t input_Q,
+                             int input_bits,
+                             quadratic_field_element_t input_A) {
+    projective_curve_alice_t curve;
+    x_only_point_t R = {0};
+    quadratic_field_element_t product, x, one;
+    int i;
+
+    to_projective_curve_alice(&curve, input_A);
+    quadratic_field_set_to_one(&one);
+    quadratic_field_set_to_one(&product);
+    quadratic_field_copy(&R.X, input_Q);
+    quadratic_field_set_to_one(&R.Z);
+    for (i = 0; i < input_bits; i++) {
+        quadratic_field_multiplication(&output_table[i].x_plus_1, R.X, product);
+        quadratic_field_copy(&output_table[i].x_minus_1, R.Z);
+        quadratic_field_multiplication(&product, product, R.Z);
+        x_only_point_doubling(&R, R, curve);
+    }
+
+    quadratic_field_inverse(&product, product);
+    for (i = input_bits - 1; i >= 0; i--) {
+        quadratic_field_multiplication(&x, output_table[i].x_plus_1, product);
+        quadratic_field_multiplication(&product, product, output_table[i].x_minus_1);
+        quadratic_field_addition(&output_table[i].x_plus_1, x, one);
+        quadratic_field_subtraction(&output_table[i].x_minus_1, x, one);
+    }
+}
+
+// x(T + R) from x(T - R), where T = (x : 1) is given as (x + 1, x - 1)
+static void x_only_point_mixed_differential_addition(x_only_point_t *input_R_output_T_plus_R,
+                                                     x_only_fixed_base_t input_T,
+                                                     x_only_point_t input_T_minus_R) {
+    quadratic_field_element_t t0, t1;
+
+    quadratic_field_subtraction(&t0, input_R_output_T_plus_R->X, input_R_output_T_plus_R->Z);
+    quadratic_field_addition(&t1, input_R_output_T_plus_R->X, input_R_output_T_plus_R->Z);
+    quadratic_field_multiplication(&t0, input_T.x_plus_1, t0);
+    quadratic_field_multiplication(&t1, input_T.x_minus_1, t1);
+    quadratic_field_addition(&input_R_output_T_plus_R->X, t0, t1);
+    quadratic_field_subtraction(&input_R_output_T_plus_R->Z, t0, t1);
+    quadratic_field_square(&input_R_output_T_plus_R->X, input_R_output_T_plus_R->X);
+    quadratic_field_square(&input_R_output_T_plus_R->Z, input_R_output_T_plus_R->Z);
+    quadratic_field_multiplication(&input_R_output_T_plus_R->X, input_T_minus_R.Z, input_R_output_T_plus_R->X);
+    quadratic_field_multiplication(&input_R_output_T_plus_R->Z, input_T_minus_R.X, input_R_output_T_plus_R->Z);
+}
+
+void x_only_three_point_ladder_fixed_base(x_only_point_t *output_P_plus_kQ,
+                                          quadratic_field_element_t input_P,
+                                          quadratic_field_element_t input_P_minus_Q,
+                                          const x_only_fixed_base_t *input_table,
+                                          const scalar_t input_k,
+                                          int input_bits_of_k) {
+    x_only_point_t R2 = {0};
+    uint64_t mask;
+    int i;
+    uint8_t bit, swap, previous_bit = 0;
+
+    quadratic_field_copy(&R2.X, input_P_minus_Q);
+    quadratic_field_set_to_one(&R2.Z);
+    quadratic_field_copy(&output_P_plus_kQ->X, input_P);
+    quadratic_field_set_to_one(&output_P_plus_kQ->Z);
+
+    // Same walk as x_only_three_point_ladder, with the doublings of Q read from the table
+    for (i = 0; i < input_bits_of_k; i++) {
+        bit = (uint8_t) (input_k[i >> 6] >> (i & (64 - 1))) & 1;
+        swap = bit ^ previous_bit;
+        previous_bit = bit;
+        mask = 0 - (uint64_t) swap;
+
+        x_only_point_swap(output_P_plus_kQ, &R2, mask);
+        x_only_point_mixed_differential_addition(&R2, input_table[i], *output_P_plus_kQ);
+    }
+    swap = 0 ^ previous_bit;
+    mask = 0 - (uint64_t) swap;
+    x_only_point_swap(output_P_plus_kQ, &R2, mask);
+}
+
+// Montgomery's simultaneous inversion, in place: X first holds X·(Z₀⋯Zᵢ₋₁)
+void x_only_points_to_affine(x_only_point_t *input_output_points, uint64_t length) {
+    quadratic_field_element_t product;
+    uint64_t i;
+
+    if (length == 0) { return; }
+    quadratic_field_set_to_one(&product);
+    for (i = 0; i < length; i++) {
+        quadratic_field_multiplication(&input_output_points[i].X, input_output_points[i].X, product);
+        quadratic_field_multiplication(&product, product, input_output_points[i].Z);
+    }
+
+    quadratic_field_inverse(&product, product);
+    for (i = length; i-- > 0;) {
+        quadratic_field_multiplication(&input_output_points[i].X, input_output_points[i].X, product);
+        quadratic_field_multiplication(&product, product, input_output_points[i].Z);
+        quadratic_field_set_to_one(&input_output_points[i].Z);
+    }
+}
+
 void to_alice_curve_representation(projective_curve_alice_t *output, projective_curve_bob_t input) {
     quadratic_field_copy(&output->A_plus_2C, input.A_plus_2C);
     quadratic_field_subtraction(&output->C_times_4, input.A_plus_2C, input.A_minus_2C);
@@ -538,6 +664,149 @@ void two_dimensional_scalar_multiplication_bob(x_only_point_t *output_cP_plus_dQ
     x_only_point_copy(output_cP_plus_dQ, x1);
 }
 
+// k = d/c, or k = c/d with *output_swap set when c is not a unit modulo 3ᵇ
+static uint8_t two_dimensional_normalized_scalar_bob(scalar_t output_k,
+                                                     uint8_t *output_swap,
+                                                     const scalar_t input_c,
+                                                     const scalar_t input_d) {
+    scalar_t order;
+
+    scalar_power_of_three(order, EXPONENT_BOB);
+    if (!multiprecision_is_smaller(input_c, order, SUBGROUP_ORDER_64BITS_WORDS)) { return EXIT_FAILURE; }
+    if (!multiprecision_is_smaller(input_d, order, SUBGROUP_ORDER_64BITS_WORDS)) { return EXIT_FAILURE; }
+
+    // Either c or d must be a unit modulo 3ᵇ, otherwise [c]P + [d]Q has not full order
+    *output_swap = 0;
+    if (multiprecision_modular_division(output_k, input_c, input_d, order, SUBGROUP_ORDER_64BITS_WORDS) == EXIT_SUCCESS) {
+        return EXIT_SUCCESS;
+    }
+    *output_swap = 1;
+    return multiprecision_modular_division(output_k, input_d, input_c, order, SUBGROUP_ORDER_64BITS_WORDS);
+}
+
+uint8_t two_dimensional_normalized_ladder_bob(x_only_point_t *output_K,
+                                              quadratic_field_element_t input_P,
+                                              quadratic_field_element_t input_Q,
+                                              quadratic_field_element_t input_P_minus_Q,
+                                              const scalar_t input_c,
+                                              const scalar_t input_d,
+                                              quadratic_field_element_t input_A) {
+    x_only_point_t P, Q, P_minus_Q;
+
+    quadratic_field_copy(&P.X, input_P);
+    quadratic_field_set_to_one(&P.Z);
+    quadratic_field_copy(&Q.X, input_Q);
+    quadratic_field_set_to_one(&Q.Z);
+    quadratic_field_copy(&P_minus_Q.X, input_P_minus_Q);
+    quadratic_field_set_to_one(&P_minus_Q.Z);
+    return two_dimensional_normalized_ladder_bob_projective(output_K, P, Q, P_minus_Q, input_c, input_d, input_A);
+}
+
+uint8_t two_dimensional_normalized_ladder_bob_projective(x_only_point_t *output_K,
+                                                         x_only_point_t input_P,
+                                                         x_only_point_t input_Q,
+                                                         x_only_point_t input_P_minus_Q,
+                                                         const scalar_t input_c,
+                                                         const scalar_t input_d,
+                                                         quadratic_field_element_t input_A) {
+    scalar_t k;
+    uint8_t swap;
+
+    if (two_dimensional_normalized_scalar_bob(k, &swap, input_c, input_d) == EXIT_FAILURE) { return EXIT_FAILURE; }
+    if (!swap) {
+        // P + [d/c]Q
+        x_only_three_point_ladder_projective(output_K,
+                                             input_P,
+                                             input_Q,
+                                             input_P_minus_Q,
+                                             k,
+                                             SUBGROUP_ORDER_BITS_BOB,
+                                             input_A);
+    } else {
+        // Q + [c/d]P, and x(Q - P) = x(P - Q)
+        x_only_three_point_ladder_projective(output_K,
+                                             input_Q,
+                                             input_P,
+                                             input_P_minus_Q,
+                                             k,
+                                             SUBGROUP_ORDER_BITS_BOB,
+                                             input_A);
+    }
+    return EXIT_SUCCESS;
+}
+
+void x_only_three_point_ladder_pair(x_only_point_t output_P_plus_kQ[2],
+                                    const x_only_point_t input_P[2],
+                                    const x_only_point_t input_Q[2],
+                                    const x_only_point_t input_P_minus_Q[2],
+                                    const scalar_t input_k,
+                                    int input_bits_of_k,
+                                    const quadratic_field_element_t input_A[2]) {
+    x_only_point_t R0[2] = {0}, R2[2] = {0};
+    quadratic_field_element_t quarter_of_A_plus_2[2] = {0};
+    uint64_t mask;
+    int i;
+    uint8_t j, bit, swap, previous_bit = 0;
+
+    for (j = 0; j < 2; j++) {
+        // Initializing constant: quarter_of_A_plus_2 = (A+2)/4
+        quadratic_field_set_to_one(&quarter_of_A_plus_2[j]);
+        quadratic_field_addition(&quarter_of_A_plus_2[j], quarter_of_A_plus_2[j], quarter_of_A_plus_2[j]);
+        quadratic_field_addition(&quarter_of_A_plus_2[j], input_A[j], quarter_of_A_plus_2[j]);
+        quadratic_field_divide_by_2(&quarter_of_A_plus_2[j], quarter_of_A_plus_2[j]);
+        quadratic_field_divide_by_2(&quarter_of_A_plus_2[j], quarter_of_A_plus_2[j]);
+
+        // Initializing points
+        x_only_point_copy(&R0[j], input_Q[j]);
+        x_only_point_copy(&R2[j], input_P_minus_Q[j]);
+        x_only_point_copy(&output_P_plus_kQ[j], input_P[j]);
+    }
+
+    // Main loop: one scalar bit drives a step on each curve
+    for (i = 0; i < input_bits_of_k; i++) {
+        bit = (uint8_t) (input_k[i >> 6] >> (i & (64 - 1))) & 1;
+        swap = bit ^ previous_bit;
+        previous_bit = bit;
+        mask = 0 - (uint64_t) swap;
+
+        x_only_point_swap(&output_P_plus_kQ[0], &R2[0], mask);
+        x_only_point_swap(&output_P_plus_kQ[1], &R2[1], mask);
+        x_only_point_simultaneous_double_and_addition(&R0[0],
+                                                      &R2[0],
+                                                      output_P_plus_kQ[0],
+                                                      quarter_of_A_plus_2[0]);
+        x_only_point_simultaneous_double_and_addition(&R0[1],
+                                                      &R2[1],
+                                                      output_P_plus_kQ[1],
+                                                      quarter_of_A_plus_2[1]);
+    }
+    swap = 0 ^ previous_bit;
+    mask = 0 - (uint64_t) swap;
+    x_only_point_swap(&output_P_plus_kQ[0], &R2[0], mask);
+    x_only_point_swap(&output_P_plus_kQ[1], &R2[1], mask);
+}
+
+uint8_t two_dimensional_normalized_ladder_bob_pair(x_only_point_t output_K[2],
+                                                   const x_only_point_t input_P[2],
+                                                   const x_only_point_t input_Q[2],
+                                                   const x_only_point_t input_P_minus_Q[2],
+                                                   const scalar_t input_c,
+                                                   const scalar_t input_d,
+                                                   const quadratic_field_element_t input_A[2]) {
+    scalar_t k;
+    uint8_t swap;
+
+    if (two_dimensional_normalized_scalar_bob(k, &swap, input_c, input_d) == EXIT_FAILURE) { return EXIT_FAILURE; }
+    if (!swap) {
+        // P + [d/c]Q on both curves
+        x_only_three_point_ladder_pair(output_K, input_P, input_Q, input_P_minus_Q, k, SUBGROUP_ORDER_BITS_BOB, input_A);
+    } else {
+        // Q + [c/d]P on both curves
+        x_only_three_point_ladder_pair(output_K, input_Q, input_P, input_P_minus_Q, k, SUBGROUP_ORDER_BITS_BOB, input_A);
+    }
+    return EXIT_SUCCESS;
+}
+
 uint8_t x_only_point_is_equal_mixed(x_only_point_t input_P, quadratic_field_element_t input_xP) {
     quadratic_field_element_t t;
     quadratic_field_multiplication(&t, input_xP, input_P.Z);
@@ -553,6 +822,18 @@ uint8_t projective_curve_is_equal_mixed_alice(projective_curve_alice_t input_cur
     return quadratic_field_is_equal(t0, t1);
 }
 
+uint8_t projective_curve_is_equal_alice(projective_curve_alice_t input_curve,
+                                        quadratic_field_element_t input_A,
+                                        quadratic_field_element_t input_C) {
+    quadratic_field_element_t t0, t1;
+    quadratic_field_addition(&t0, input_curve.A_plus_2C, input_curve.A_plus_2C);
+    quadratic_field_subtraction(&t0, t0, input_curve.C_times_4);
+    quadratic_field_addition(&t0, t0, t0);                                              // 4A
+    quadratic_field_multiplication(&t0, t0, input_C);
+    quadratic_field_multiplication(&t1, input_curve.C_times_4, input_A);
+    return quadratic_field_is_equal(t0, t1);
+}
+
 uint8_t projective_curve_is_equal_mixed_bob(projective_curve_bob_t input_curve, quadratic_field_element_t input_A) {
     quadratic_field_element_t t0, t1;
     quadratic_field_subtraction(&t0, input_curve.A_plus_2C, input_curve.A_minus_2C);    // 4C
@@ -24,6 +24,14 @@ typedef struct {
     quadratic_field_element_t A_minus_2C;
 } projective_curve_bob_t; // projective curve A-coefficient (A' + 2C : A - 2C) determining A = A'/C
 
+typedef struct {
+    quadratic_field_element_t x_plus_1;
+    quadratic_field_element_t x_minus_1;
+} x_only_fixed_base_t; // affine x([2ⁱ]Q) stored as (x + 1, x - 1), as used by the fixed-base ladder
+
+// 3ᵉ as a multiprecision scalar
+void scalar_power_of_three(scalar_t output, int input_e);
+
 void x_only_point_copy(x_only_point_t *output, x_only_point_t input);
 
 void x_only_point_doubling(x_only_point_t *output,
@@ -59,6 +67,32 @@ void x_only_three_point_ladder(x_only_point_t *output_P_plus_kQ,
                                int input_bits_of_k,
                                quadratic_field_element_t input_A);
 
+// Same ladder on projective inputs: the differences P - Q and P are used with their Z-coordinates, at no extra cost
+void x_only_three_point_ladder_projective(x_only_point_t *output_P_plus_kQ,
+                                          x_only_point_t input_P,
+                                          x_only_point_t input_Q,
+                                          x_only_point_t input_P_minus_Q,
+                                          const scalar_t input_k,
+                                          int input_bits_of_k,
+                                          quadratic_field_element_t input_A);
+
+// Fixed-base table of x_only_three_point_ladder_fixed_base: input_bits entries, one per doubling of Q
+void x_only_fixed_base_table(x_only_fixed_base_t *output_table,
+                             quadratic_field_element_t input_Q,
+                             int input_bits,
+                             quadratic_field_element_t input_A);
+
+// x(P + [k]Q) with one differential addition per bit, Q being given by its fixed-base table
+void x_only_three_point_ladder_fixed_base(x_only_point_t *output_P_plus_kQ,
+                                          quadratic_field_element_t input_P,
+                                          quadratic_field_element_t input_P_minus_Q,
+                                          const x_only_fixed_base_t *input_table,
+                                          const scalar_t input_k,
+                                          int input_bits_of_k);
+
+// (X : Z) to (X/Z : 1) for every point with a single inversion; no point may be at infinity
+void x_only_points_to_affine(x_only_point_t *input_output_points, uint64_t length);
+
 void to_alice_curve_representation(projective_curve_alice_t *output, projective_curve_bob_t input);
 
 void to_projective_curve_alice(projective_curve_alice_t *output, quadratic_field_element_t input);
@@ -128,12 +162,53 @@ void two_dimensional_scalar_multiplication_bob(x_only_point_t *output_cP_plus_dQ
                                                const scalar_t input_d,
                                                quadratic_field_element_t input_A);
 
+// Same subgroup as <[c]P + [d]Q> but generated by either P + [d/c]Q or [c/d]P + Q, thus a scalar multiple of [c]P + [d]Q.
+// The division modulo 3ᵇ is non-constant-time (c and d are public), while the ladder is the constant-time three-point one
+uint8_t two_dimensional_normalized_ladder_bob(x_only_point_t *output_K,
+                                              quadratic_field_element_t input_P,
+                                              quadratic_field_element_t input_Q,
+                                              quadratic_field_element_t input_P_minus_Q,
+                                              const scalar_t input_c,
+                                              const scalar_t input_d,
+                                              quadratic_field_element_t input_A);
+
+uint8_t two_dimensional_normalized_ladder_bob_projective(x_only_point_t *output_K,
+                                                         x_only_point_t input_P,
+                                                         x_only_point_t input_Q,
+                                                         x_only_point_t input_P_minus_Q,
+                                                         const scalar_t input_c,
+                                                         const scalar_t input_d,
+                                                         quadratic_field_element_t input_A);
+
+// Three-point ladders on two curves in lockstep: both share the scalar, and thus the sequence of swaps
+void x_only_three_point_ladder_pair(x_only_point_t output_P_plus_kQ[2],
+                                    const x_only_point_t input_P[2],
+                                    const x_only_point_t input_Q[2],
+                                    const x_only_point_t input_P_minus_Q[2],
+                                    const scalar_t input_k,
+                                    int input_bits_of_k,
+                                    const quadratic_field_element_t input_A[2]);
+
+// two_dimensional_normalized_ladder_bob on two curves with the same scalars, reducing them once
+uint8_t two_dimensional_normalized_ladder_bob_pair(x_only_point_t output_K[2],
+                                                   const x_only_point_t input_P[2],
+                                                   const x_only_point_t input_Q[2],
+                                                   const x_only_point_t input_P_minus_Q[2],
+                                                   const scalar_t input_c,
+                                                   const scalar_t input_d,
+                                                   const quadratic_field_element_t input_A[2]);
+
 // No inverse computation
 uint8_t x_only_point_is_equal_mixed(x_only_point_t input_P, quadratic_field_element_t input_xP);
 
 // No inverse computation
 uint8_t projective_curve_is_equal_mixed_alice(projective_curve_alice_t input_curve, quadratic_field_element_t input_A);
 
+// No inverse computation: (A : C) against E
+uint8_t projective_curve_is_equal_alice(projective_curve_alice_t input_curve,
+                                        quadratic_field_element_t input_A,
+                                        quadratic_field_element_t input_C);
+
 // No inverse computation
 uint8_t projective_curve_is_equal_mixed_bob(projective_curve_bob_t input_curve, quadratic_field_element_t input_A);
 
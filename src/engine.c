@@ -0,0 +1,320 @@
+//
+// Asynchronous signing and verification engine: round-level tasks on a work-stealing thread pool
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "engine.h"
+#include "fips202x4.h"
+
+#define ENGINE_PHASE_COMMITMENT     0
+#define ENGINE_PHASE_RESPONSE       1
+#define ENGINE_PHASE_VERIFICATION   2
+
+// Rounds [begin, end) of a job; ranges are split in halves until single rounds
+typedef struct {
+    sidh_engine_job_t *job;
+    uint16_t begin;
+    uint16_t end;
+} engine_range_t;
+
+// Each worker owns one deque per priority: the owner pushes and pops at the bottom, thieves steal from the top
+typedef struct {
+    pthread_mutex_t lock;
+    engine_range_t ranges[SIDH_ENGINE_PRIORITIES][SIDH_ENGINE_DEQUE_CAPACITY];
+    unsigned int top[SIDH_ENGINE_PRIORITIES];
+    unsigned int bottom[SIDH_ENGINE_PRIORITIES];
+    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS];
+    pthread_t thread;
+    unsigned int index;
+    sidh_engine_t *engine;
+} engine_worker_t;
+
+struct sidh_engine {
+    engine_worker_t *workers;
+    unsigned int number_of_workers;
+    atomic_uint next_worker;
+    atomic_int pending;             // queued ranges over all deques
+    pthread_mutex_t lock;           // sleeping workers and job completion
+    pthread_cond_t work;
+    pthread_cond_t completion;
+    uint8_t stop;
+};
+
+static void engine_execute(engine_worker_t *worker, engine_range_t range);
+
+static uint8_t engine_push(engine_worker_t *worker, engine_range_t range) {
+    sidh_engine_t *engine = worker->engine;
+    uint8_t level = range.job->priority;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->bottom[level] - worker->top[level] == SIDH_ENGINE_DEQUE_CAPACITY) {
+        pthread_mutex_unlock(&worker->lock);
+        return EXIT_FAILURE;
+    }
+    worker->ranges[level][worker->bottom[level]++ % SIDH_ENGINE_DEQUE_CAPACITY] = range;
+    pthread_mutex_unlock(&worker->lock);
+
+    atomic_fetch_add(&engine->pending, 1);
+    pthread_mutex_lock(&engine->lock);
+    pthread_cond_signal(&engine->work);
+    pthread_mutex_unlock(&engine->lock);
+    return EXIT_SUCCESS;
+}
+
+static uint8_t engine_pop(engine_worker_t *worker, uint8_t level, uint8_t steal, engine_range_t *range) {
+    uint8_t found = 0;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->bottom[level] != worker->top[level]) {
+        if (steal) {
+            *range = worker->ranges[level][worker->top[level]++ % SIDH_ENGINE_DEQUE_CAPACITY];
+        } else {
+            *range = worker->ranges[level][--worker->bottom[level] % SIDH_ENGINE_DEQUE_CAPACITY];
+        }
+        found = 1;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    if (found) { atomic_fetch_sub(&worker->engine->pending, 1); }
+    return found;
+}
+
+// Highest priority first: own deque, then steal from the others
+static uint8_t engine_take(engine_worker_t *worker, engine_range_t *range) {
+    sidh_engine_t *engine = worker->engine;
+
+    for (int level = SIDH_ENGINE_PRIORITIES - 1; level >= 0; level--) {
+        if (engine_pop(worker, level, 0, range)) { return 1; }
+        for (unsigned int k = 1; k < engine->number_of_workers; k++) {
+            engine_worker_t *victim = &engine->workers[(worker->index + k) % engine->number_of_workers];
+            if (engine_pop(victim, level, 1, range)) { return 1; }
+        }
+    }
+    return 0;
+}
+
+static void engine_complete(sidh_engine_job_t *job) {
+    sidh_engine_t *engine = job->engine;
+
+    job->result = atomic_load(&job->failed) ? EXIT_FAILURE : EXIT_SUCCESS;
+    if (job->callback != NULL) {
+        job->callback(job, job->user_data);
+        return;
+    }
+    pthread_mutex_lock(&engine->lock);
+    atomic_store(&job->done, 1);
+    pthread_cond_broadcast(&engine->completion);
+    pthread_mutex_unlock(&engine->lock);
+}
+
+// Per-round randomness is SHAKE256(seed || round); four rounds share one 4-way absorption
+static void engine_commitments(sidh_engine_job_t *job, uint16_t begin, uint16_t end) {
+    uint8_t inputs[SIDH_ENGINE_KECCAK_WAYS][SIDH_ENGINE_SEED_BYTES + 2];
+    keccak_state states[SIDH_ENGINE_KECCAK_WAYS];
+    uint16_t round, lane;
+
+    for (; begin < end; begin += SIDH_ENGINE_KECCAK_WAYS) {
+        for (lane = 0; lane < SIDH_ENGINE_KECCAK_WAYS; lane++) {
+            // Lanes past the end repeat the last round and are discarded
+            round = (begin + lane < end) ? begin + lane : end - 1;
+            memcpy(inputs[lane], job->seed, SIDH_ENGINE_SEED_BYTES);
+            inputs[lane][SIDH_ENGINE_SEED_BYTES] = round & 0xFF;
+            inputs[lane][SIDH_ENGINE_SEED_BYTES + 1] = round >> 8;
+        }
+        shake256x4_split(states, inputs[0], inputs[1], inputs[2], inputs[3], sizeof(inputs[0]));
+
+        for (lane = 0; lane < SIDH_ENGINE_KECCAK_WAYS && begin + lane < end; lane++) {
+            round = begin + lane;
+            if (sidh_pok_commitment_insight(&job->signature[COMMITMENT_BYTES * round], &job->insights[round],
+                                            job->private_key, &states[lane]) != EXIT_SUCCESS) {
+                atomic_store(&job->failed, 1);
+            }
+        }
+    }
+}
+
+static void engine_round(engine_worker_t *worker, sidh_engine_job_t *job, uint16_t round) {
+    uint8_t returned_value, challenge = (job->challenge_bytes[round / 8] >> (round % 8)) & 1;
+    uint8_t *commit = &job->signature[COMMITMENT_BYTES * round];
+    uint8_t *resp = &job->signature[(COMMITMENT_BYTES * SECURITY_BITS) + (RESPONSE_BYTES * round)];
+
+    if (job->phase == ENGINE_PHASE_RESPONSE) {
+        returned_value = sidh_pok_response_insight(resp, &job->insights[round], challenge, worker->workspace);
+    } else if (atomic_load(&job->failed)) {
+        // A rejected signature needs no further rounds; verification is public so the early exit leaks nothing
+        return;
+    } else {
+        returned_value = sidh_pok_verification(commit, resp, job->public_key, challenge);
+    }
+    if (returned_value != EXIT_SUCCESS) { atomic_store(&job->failed, 1); }
+}
+
+// The worker finishing the last round of a phase moves the job forward
+static void engine_rounds_done(engine_worker_t *worker, sidh_engine_job_t *job, int rounds) {
+    if (atomic_fetch_sub(&job->remaining, rounds) != rounds) { return; }
+
+    if (job->phase == ENGINE_PHASE_COMMITMENT) {
+        engine_range_t range = {job, 0, SECURITY_BITS};
+        sidh_signature_challenge(job->challenge_bytes, job->signature, job->message, job->message_length,
+                                 job->public_key);
+        job->phase = ENGINE_PHASE_RESPONSE;
+        atomic_store(&job->remaining, SECURITY_BITS);
+        if (engine_push(worker, range) != EXIT_SUCCESS) { engine_execute(worker, range); }
+    } else {
+        engine_complete(job);
+    }
+}
+
+static void engine_execute(engine_worker_t *worker, engine_range_t range) {
+    sidh_engine_job_t *job = range.job;
+    uint16_t middle, grain = (job->phase == ENGINE_PHASE_COMMITMENT) ? SIDH_ENGINE_KECCAK_WAYS : 1;
+
+    // Upper halves become stealable; a full deque keeps the rest of the range here
+    while (range.end - range.begin > grain) {
+        middle = (uint16_t) ((range.begin + range.end) / 2);
+        engine_range_t upper = {job, middle, range.end};
+        if (engine_push(worker, upper) != EXIT_SUCCESS) { break; }
+        range.end = middle;
+    }
+    if (job->phase == ENGINE_PHASE_COMMITMENT) {
+        engine_commitments(job, range.begin, range.end);
+    } else {
+        for (uint16_t round = range.begin; round < range.end; round++) {
+            engine_round(worker, job, round);
+        }
+    }
+    engine_rounds_done(worker, job, range.end - range.begin);
+}
+
+static void *engine_worker(void *argument) {
+    engine_worker_t *worker = (engine_worker_t *) argument;
+    sidh_engine_t *engine = worker->engine;
+    engine_range_t range;
+
+    for (;;) {
+        if (engine_take(worker, &range)) {
+            engine_execute(worker, range);
+            continue;
+        }
+        pthread_mutex_lock(&engine->lock);
+        while (atomic_load(&engine->pending) == 0 && !engine->stop) {
+            pthread_cond_wait(&engine->work, &engine->lock);
+        }
+        if (atomic_load(&engine->pending) == 0 && engine->stop) {
+            pthread_mutex_unlock(&engine->lock);
+            return NULL;
+        }
+        pthread_mutex_unlock(&engine->lock);
+    }
+}
+
+sidh_engine_t *sidh_engine_create(unsigned int number_of_threads) {
+    sidh_engine_t *engine;
+    unsigned int i;
+
+    if (number_of_threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        number_of_threads = (cores > 0) ? (unsigned int) cores : 1;
+    }
+    engine = calloc(1, sizeof(sidh_engine_t));
+    if (engine == NULL) { return NULL; }
+    engine->workers = calloc(number_of_threads, sizeof(engine_worker_t));
+    if (engine->workers == NULL) {
+        free(engine);
+        return NULL;
+    }
+    engine->number_of_workers = number_of_threads;
+    atomic_init(&engine->next_worker, 0);
+    atomic_init(&engine->pending, 0);
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->work, NULL);
+    pthread_cond_init(&engine->completion, NULL);
+
+    for (i = 0; i < number_of_threads; i++) {
+        engine->workers[i].index = i;
+        engine->workers[i].engine = engine;
+        pthread_mutex_init(&engine->workers[i].lock, NULL);
+    }
+    for (i = 0; i < number_of_threads; i++) {
+        if (pthread_create(&engine->workers[i].thread, NULL, engine_worker, &engine->workers[i]) != 0) {
+            engine->number_of_workers = i;
+            sidh_engine_destroy(engine);
+            return NULL;
+        }
+    }
+    return engine;
+}
+
+void sidh_engine_destroy(sidh_engine_t *engine) {
+    unsigned int i;
+
+    if (engine == NULL) { return; }
+    pthread_mutex_lock(&engine->lock);
+    engine->stop = 1;
+    pthread_cond_broadcast(&engine->work);
+    pthread_mutex_unlock(&engine->lock);
+
+    for (i = 0; i < engine->number_of_workers; i++) {
+        pthread_join(engine->workers[i].thread, NULL);
+        pthread_mutex_destroy(&engine->workers[i].lock);
+    }
+    pthread_cond_destroy(&engine->completion);
+    pthread_cond_destroy(&engine->work);
+    pthread_mutex_destroy(&engine->lock);
+    free(engine->workers);
+    free(engine);
+}
+
+uint8_t sidh_engine_submit(sidh_engine_t *engine, sidh_engine_job_t *job, keccak_state *state) {
+    unsigned int i, first;
+
+    if (engine == NULL || engine->number_of_workers == 0 || job == NULL || job->message_length == 0 ||
+        job->priority >= SIDH_ENGINE_PRIORITIES || job->public_key == NULL || job->signature == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    job->engine = engine;
+    job->result = EXIT_FAILURE;
+    atomic_init(&job->failed, 0);
+    atomic_init(&job->done, 0);
+    atomic_init(&job->remaining, SECURITY_BITS);
+    if (job->kind == SIDH_ENGINE_JOB_SIGN) {
+        if (job->private_key == NULL || state == NULL) { return EXIT_FAILURE; }
+        shake256_squeeze(job->seed, SIDH_ENGINE_SEED_BYTES, state);
+        job->phase = ENGINE_PHASE_COMMITMENT;
+    } else if (job->kind == SIDH_ENGINE_JOB_VERIFY) {
+        sidh_signature_challenge(job->challenge_bytes, job->signature, job->message, job->message_length,
+                                 job->public_key);
+        job->phase = ENGINE_PHASE_VERIFICATION;
+    } else {
+        return EXIT_FAILURE;
+    }
+
+    // Round-robin injection; any non-full deque will do
+    engine_range_t range = {job, 0, SECURITY_BITS};
+    first = atomic_fetch_add(&engine->next_worker, 1);
+    for (i = 0; i < engine->number_of_workers; i++) {
+        if (engine_push(&engine->workers[(first + i) % engine->number_of_workers], range) == EXIT_SUCCESS) {
+            return EXIT_SUCCESS;
+        }
+    }
+    return EXIT_FAILURE;
+}
+
+uint8_t sidh_engine_poll(sidh_engine_job_t *job) {
+    return atomic_load(&job->done);
+}
+
+uint8_t sidh_engine_wait(sidh_engine_job_t *job) {
+    sidh_engine_t *engine = job->engine;
+
+    pthread_mutex_lock(&engine->lock);
+    while (!atomic_load(&job->done)) {
+        pthread_cond_wait(&engine->completion, &engine->lock);
+    }
+    pthread_mutex_unlock(&engine->lock);
+    return job->result;
+}
@@ -0,0 +1,70 @@
+//
+// Asynchronous signing and verification engine: round-level tasks on a work-stealing thread pool
+//
+
+#ifndef SIDH_POK_ENGINE_H
+#define SIDH_POK_ENGINE_H
+
+#include <stdatomic.h>
+#include "signature.h"
+
+#define SIDH_ENGINE_PRIORITIES          3       // low, normal, and high
+#define SIDH_ENGINE_PRIORITY_LOW        0
+#define SIDH_ENGINE_PRIORITY_NORMAL     1
+#define SIDH_ENGINE_PRIORITY_HIGH       2
+#define SIDH_ENGINE_DEQUE_CAPACITY      256     // round ranges per worker and priority
+#define SIDH_ENGINE_SEED_BYTES          (SECURITY_BITS / 8)
+#define SIDH_ENGINE_KECCAK_WAYS         4       // commitment rounds derived per 4-way SHAKE256
+
+#define SIDH_ENGINE_JOB_SIGN            0
+#define SIDH_ENGINE_JOB_VERIFY          1
+
+typedef struct sidh_engine sidh_engine_t;
+typedef struct sidh_engine_job sidh_engine_job_t;
+
+// Invoked by a worker once the job completes; the engine no longer touches the job afterwards
+typedef void (*sidh_engine_callback_t)(sidh_engine_job_t *job, void *user_data);
+
+// Caller-allocated job: it must stay valid until completion (callback invoked, or poll/wait report it done)
+struct sidh_engine_job {
+    // Inputs
+    uint8_t kind;                       // SIDH_ENGINE_JOB_SIGN or SIDH_ENGINE_JOB_VERIFY
+    uint8_t priority;                   // SIDH_ENGINE_PRIORITY_*
+    const uint8_t *message;
+    uint64_t message_length;
+    const uint8_t *private_key;         // SECRET_KEY_BYTES, signing only
+    const uint8_t *public_key;          // PUBLIC_KEY_BYTES
+    uint8_t *signature;                 // SIGNATURE_BYTES: output when signing, input when verifying
+    sidh_engine_callback_t callback;    // optional; if set, poll/wait must not be used on the job
+    void *user_data;
+
+    // Output
+    uint8_t result;                     // EXIT_SUCCESS or EXIT_FAILURE, valid once completed
+
+    // Internal state
+    sidh_engine_t *engine;
+    uint8_t phase;
+    atomic_int remaining;
+    atomic_uchar failed;
+    atomic_uchar done;
+    uint8_t seed[SIDH_ENGINE_SEED_BYTES];
+    uint8_t challenge_bytes[SECURITY_BITS / 8];
+    sidh_pok_insight_t insights[SECURITY_BITS];
+};
+
+// Zero threads means one per online core
+sidh_engine_t *sidh_engine_create(unsigned int number_of_threads);
+
+// Pending jobs are completed before the workers exit
+void sidh_engine_destroy(sidh_engine_t *engine);
+
+// Signing draws a per-job seed from state (per-round randomness is derived from it, so rounds run in any order)
+uint8_t sidh_engine_submit(sidh_engine_t *engine, sidh_engine_job_t *job, keccak_state *state);
+
+// Non-blocking: 1 once the job completed
+uint8_t sidh_engine_poll(sidh_engine_job_t *job);
+
+// Blocks until the job completed and returns its result
+uint8_t sidh_engine_wait(sidh_engine_job_t *job);
+
+#endif //SIDH_POK_ENGINE_H
@@ -73,13 +73,13 @@ static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
 };
 
 /*************************************************
-* Name:        KeccakF1600_StatePermute
+* Name:        KeccakF1600_StatePermute_rounds
 *
-* Description: The Keccak F1600 Permutation
+* Description: The Keccak F1600 Permutation, inlined into each dispatch target
 *
 * Arguments:   - uint64_t *state: pointer to input/output Keccak state
 **************************************************/
-static void KeccakF1600_StatePermute(uint64_t state[25]) {
+static inline __attribute__((always_inline)) void KeccakF1600_StatePermute_rounds(uint64_t state[25]) {
     int round;
 
     uint64_t Aba, Abe, Abi, Abo, Abu;
@@ -342,6 +342,35 @@ static void KeccakF1600_StatePermute(uint64_t state[25]) {
     state[24] = Asu;
 }
 
+static void KeccakF1600_StatePermute_generic(uint64_t state[25]) {
+    KeccakF1600_StatePermute_rounds(state);
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+// ANDN folds the chi step and RORX keeps the rotation sources live, which saves most register moves
+__attribute__((target("bmi,bmi2"))) static void KeccakF1600_StatePermute_bmi2(uint64_t state[25]) {
+    KeccakF1600_StatePermute_rounds(state);
+}
+#endif
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute
+*
+* Description: The Keccak F1600 Permutation, dispatched on the CPU features at runtime
+*
+* Arguments:   - uint64_t *state: pointer to input/output Keccak state
+**************************************************/
+void KeccakF1600_StatePermute(uint64_t state[25]) {
+#if defined(__GNUC__) && defined(__x86_64__)
+    // The variant is built for both BMI1 (ANDN) and BMI2 (RORX), which CPUs report separately
+    if (__builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2")) {
+        KeccakF1600_StatePermute_bmi2(state);
+        return;
+    }
+#endif
+    KeccakF1600_StatePermute_generic(state);
+}
+
 /*************************************************
 * Name:        keccak_init
 *
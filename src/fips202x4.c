@@ -0,0 +1,278 @@
+/* Four-way SHAKE256 on interleaved Keccak states, following the layout of the Kyber AVX2 fips202x4.
+ * The AVX2 permutation is selected at runtime; other CPUs permute the four states one at a time. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fips202x4.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define FIPS202X4_AVX2
+#endif
+
+#define NROUNDS 24
+
+#ifdef FIPS202X4_AVX2
+/* Keccak round constants */
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+        (uint64_t) 0x0000000000000001ULL,
+        (uint64_t) 0x0000000000008082ULL,
+        (uint64_t) 0x800000000000808aULL,
+        (uint64_t) 0x8000000080008000ULL,
+        (uint64_t) 0x000000000000808bULL,
+        (uint64_t) 0x0000000080000001ULL,
+        (uint64_t) 0x8000000080008081ULL,
+        (uint64_t) 0x8000000000008009ULL,
+        (uint64_t) 0x000000000000008aULL,
+        (uint64_t) 0x0000000000000088ULL,
+        (uint64_t) 0x0000000080008009ULL,
+        (uint64_t) 0x000000008000000aULL,
+        (uint64_t) 0x000000008000808bULL,
+        (uint64_t) 0x800000000000008bULL,
+        (uint64_t) 0x8000000000008089ULL,
+        (uint64_t) 0x8000000000008003ULL,
+        (uint64_t) 0x8000000000008002ULL,
+        (uint64_t) 0x8000000000000080ULL,
+        (uint64_t) 0x000000000000800aULL,
+        (uint64_t) 0x800000008000000aULL,
+        (uint64_t) 0x8000000080008081ULL,
+        (uint64_t) 0x8000000000008080ULL,
+        (uint64_t) 0x0000000080000001ULL,
+        (uint64_t) 0x8000000080008008ULL
+};
+
+/* Rho offsets, indexed by x + 5y */
+static const unsigned int KeccakF_RhoOffsets[25] = {
+        0, 1, 62, 28, 27,
+        36, 44, 6, 55, 20,
+        3, 10, 43, 25, 39,
+        41, 45, 15, 21, 8,
+        18, 2, 61, 56, 14
+};
+
+#define ROL4X(a, offset) _mm256_or_si256(_mm256_slli_epi64(a, offset), _mm256_srli_epi64(a, 64 - (offset)))
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute4x_avx2
+*
+* Description: The Keccak F1600 Permutation on four interleaved states, one per 64-bit AVX2 lane
+*
+* Arguments:   - uint64_t state[25][4]: pointer to input/output Keccak states
+**************************************************/
+__attribute__((target("avx2"))) static void KeccakF1600_StatePermute4x_avx2(uint64_t state[25][4]) {
+    __m256i A[25], B[25], C[5], D;
+    int round, x, y;
+
+    for (x = 0; x < 25; x++)
+        A[x] = _mm256_loadu_si256((const __m256i *) state[x]);
+
+    for (round = 0; round < NROUNDS; round++) {
+        // Theta
+        for (x = 0; x < 5; x++)
+            C[x] = _mm256_xor_si256(_mm256_xor_si256(A[x], A[x + 5]),
+                                    _mm256_xor_si256(_mm256_xor_si256(A[x + 10], A[x + 15]), A[x + 20]));
+        for (x = 0; x < 5; x++) {
+            D = _mm256_xor_si256(C[(x + 4) % 5], ROL4X(C[(x + 1) % 5], 1));
+            for (y = 0; y < 25; y += 5)
+                A[x + y] = _mm256_xor_si256(A[x + y], D);
+        }
+
+        // Rho and pi: B[y, 2x + 3y] = ROL(A[x, y])
+        for (x = 0; x < 5; x++)
+            for (y = 0; y < 5; y++)
+                B[y + 5 * ((2 * x + 3 * y) % 5)] = ROL4X(A[x + 5 * y], KeccakF_RhoOffsets[x + 5 * y]);
+
+        // Chi
+        for (y = 0; y < 25; y += 5)
+            for (x = 0; x < 5; x++)
+                A[x + y] = _mm256_xor_si256(B[x + y], _mm256_andnot_si256(B[(x + 1) % 5 + y], B[(x + 2) % 5 + y]));
+
+        // Iota
+        A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x((long long) KeccakF_RoundConstants[round]));
+    }
+
+    for (x = 0; x < 25; x++)
+        _mm256_storeu_si256((__m256i *) state[x], A[x]);
+}
+#endif
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute4x
+*
+* Description: The Keccak F1600 Permutation on four interleaved states, dispatched on the CPU features at runtime
+*
+* Arguments:   - uint64_t state[25][4]: pointer to input/output Keccak states
+**************************************************/
+void KeccakF1600_StatePermute4x(uint64_t state[25][4]) {
+    uint64_t s[25];
+    unsigned int i, j;
+
+#ifdef FIPS202X4_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        KeccakF1600_StatePermute4x_avx2(state);
+        return;
+    }
+#endif
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 25; i++)
+            s[i] = state[i][j];
+        KeccakF1600_StatePermute(s);
+        for (i = 0; i < 25; i++)
+            state[i][j] = s[i];
+    }
+}
+
+static uint64_t load64(const uint8_t x[8]) {
+    unsigned int i;
+    uint64_t r = 0;
+
+    for (i = 0; i < 8; i++)
+        r |= (uint64_t) x[i] << 8 * i;
+
+    return r;
+}
+
+static void store64(uint8_t x[8], uint64_t u) {
+    unsigned int i;
+
+    for (i = 0; i < 8; i++)
+        x[i] = u >> 8 * i;
+}
+
+/*************************************************
+* Name:        shake256x4_absorb_once
+*
+* Description: Absorb step of four SHAKE256 instances on inputs of equal length;
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx4_state *state: pointer to (uninitialized) output Keccak states
+*              - const uint8_t *in0, ..., *in3: pointers to inputs to be absorbed
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            const uint8_t *in2,
+                            const uint8_t *in3,
+                            size_t inlen) {
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+    unsigned int i, j;
+    size_t offset = 0;
+
+    memset(state->s, 0, sizeof(state->s));
+
+    while (inlen - offset >= SHAKE256_RATE) {
+        for (i = 0; i < SHAKE256_RATE / 8; i++)
+            for (j = 0; j < 4; j++)
+                state->s[i][j] ^= load64(in[j] + offset + 8 * i);
+        offset += SHAKE256_RATE;
+        KeccakF1600_StatePermute4x(state->s);
+    }
+
+    for (i = 0; i < inlen - offset; i++)
+        for (j = 0; j < 4; j++)
+            state->s[i / 8][j] ^= (uint64_t) in[j][offset + i] << 8 * (i % 8);
+
+    for (j = 0; j < 4; j++) {
+        state->s[i / 8][j] ^= (uint64_t) 0x1F << 8 * (i % 8);
+        state->s[(SHAKE256_RATE - 1) / 8][j] ^= 1ULL << 63;
+    }
+}
+
+/*************************************************
+* Name:        shake256x4_squeezeblocks
+*
+* Description: Squeeze step of four SHAKE256 instances. Squeezes full blocks of
+*              SHAKE256_RATE bytes per instance; can be called multiple times.
+*
+* Arguments:   - uint8_t *out0, ..., *out3: pointers to output blocks
+*              - size_t nblocks: number of blocks to be squeezed per instance
+*              - keccakx4_state *state: pointer to input/output Keccak states
+**************************************************/
+void shake256x4_squeezeblocks(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              uint8_t *out3,
+                              size_t nblocks,
+                              keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    unsigned int i, j;
+    size_t offset = 0;
+
+    while (nblocks) {
+        KeccakF1600_StatePermute4x(state->s);
+        for (i = 0; i < SHAKE256_RATE / 8; i++)
+            for (j = 0; j < 4; j++)
+                store64(out[j] + offset + 8 * i, state->s[i][j]);
+        offset += SHAKE256_RATE;
+        nblocks -= 1;
+    }
+}
+
+/*************************************************
+* Name:        shake256x4
+*
+* Description: SHAKE256 XOF on four inputs of equal length with non-incremental API
+*
+* Arguments:   - uint8_t *out0, ..., *out3: pointers to outputs
+*              - size_t outlen: requested output length in bytes per instance
+*              - const uint8_t *in0, ..., *in3: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void shake256x4(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                const uint8_t *in3,
+                size_t inlen) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    uint8_t block[4][SHAKE256_RATE];
+    keccakx4_state state;
+    size_t nblocks = outlen / SHAKE256_RATE;
+    unsigned int j;
+
+    shake256x4_absorb_once(&state, in0, in1, in2, in3, inlen);
+    shake256x4_squeezeblocks(out0, out1, out2, out3, nblocks, &state);
+
+    outlen -= nblocks * SHAKE256_RATE;
+    if (outlen) {
+        shake256x4_squeezeblocks(block[0], block[1], block[2], block[3], 1, &state);
+        for (j = 0; j < 4; j++)
+            memcpy(out[j] + nblocks * SHAKE256_RATE, block[j], outlen);
+    }
+}
+
+/*************************************************
+* Name:        shake256x4_split
+*
+* Description: Absorbs four inputs of equal length and permutes the four states together,
+*              then hands them out as independent incremental SHAKE256 states. Squeezing
+*              from states[j] gives the same stream as shake256_absorb_once on in<j>.
+*
+* Arguments:   - keccak_state states[4]: output SHAKE256 states, ready to squeeze
+*              - const uint8_t *in0, ..., *in3: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void shake256x4_split(keccak_state states[4],
+                      const uint8_t *in0,
+                      const uint8_t *in1,
+                      const uint8_t *in2,
+                      const uint8_t *in3,
+                      size_t inlen) {
+    keccakx4_state state;
+    unsigned int i, j;
+
+    shake256x4_absorb_once(&state, in0, in1, in2, in3, inlen);
+    KeccakF1600_StatePermute4x(state.s);
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 25; i++)
+            states[j].s[i] = state.s[i][j];
+        // The first block is already permuted
+        states[j].pos = 0;
+    }
+}
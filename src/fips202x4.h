@@ -0,0 +1,57 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fips202.h"
+
+// Four interleaved Keccak states: lane i of stream j is s[i][j]
+typedef struct {
+    uint64_t s[25][4];
+} keccakx4_state;
+
+#define KeccakF1600_StatePermute4x FIPS202_NAMESPACE(KeccakF1600_StatePermute4x)
+
+void KeccakF1600_StatePermute4x(uint64_t state[25][4]);
+
+#define shake256x4_absorb_once FIPS202_NAMESPACE(shake256x4_absorb_once)
+
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            const uint8_t *in2,
+                            const uint8_t *in3,
+                            size_t inlen);
+
+#define shake256x4_squeezeblocks FIPS202_NAMESPACE(shake256x4_squeezeblocks)
+
+void shake256x4_squeezeblocks(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              uint8_t *out3,
+                              size_t nblocks,
+                              keccakx4_state *state);
+
+#define shake256x4 FIPS202_NAMESPACE(shake256x4)
+
+void shake256x4(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                const uint8_t *in3,
+                size_t inlen);
+
+#define shake256x4_split FIPS202_NAMESPACE(shake256x4_split)
+
+void shake256x4_split(keccak_state states[4],
+                      const uint8_t *in0,
+                      const uint8_t *in1,
+                      const uint8_t *in2,
+                      const uint8_t *in3,
+                      size_t inlen);
+
+#endif
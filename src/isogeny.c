@@ -42,6 +42,33 @@ void x_only_2_isogeny_evaluation(x_only_point_t *output, x_only_point_t input, x
     quadratic_field_multiplication(&output->Z, t3, input.Z);
 }
 
+void x_only_2_isogeny_evaluation_batch(x_only_point_t *input_output_points,
+                                       int input_number_of_points,
+                                       x_only_point_t input_kernel) {
+    int i, j;
+    quadratic_field_element_t k0, k1, t0[2], t1[2], t2[2], t3[2];
+
+    // Kernel sums are shared by all the points
+    quadratic_field_addition(&k0, input_kernel.X, input_kernel.Z);
+    quadratic_field_subtraction(&k1, input_kernel.X, input_kernel.Z);
+
+    // Two independent points per iteration, step by step
+    for (i = 0; i + 1 < input_number_of_points; i += 2) {
+        x_only_point_t *R = &input_output_points[i];
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&t2[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&t3[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&t0[j], t3[j], k0); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&t1[j], t2[j], k1); }
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&t2[j], t0[j], t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&t3[j], t0[j], t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].X, t2[j], R[j].X); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].Z, t3[j], R[j].Z); }
+    }
+    if (i < input_number_of_points) {
+        x_only_2_isogeny_evaluation(&input_output_points[i], input_output_points[i], input_kernel);
+    }
+}
+
 #endif
 
 void x_only_4_isogeny(projective_curve_alice_t *output_curve,
@@ -86,16 +113,54 @@ void x_only_4_isogeny_evaluation(x_only_point_t *output,
     quadratic_field_multiplication(&output->Z, output->Z, t0);
 }
 
+void x_only_4_isogeny_evaluation_batch(x_only_point_t *input_output_points,
+                                       int input_number_of_points,
+                                       const quadratic_field_element_t input_isogeny_coefficients[3]) {
+    int i, j;
+    quadratic_field_element_t c0, c1, c2, t0[2], t1[2];
+
+    quadratic_field_copy(&c0, input_isogeny_coefficients[0]);
+    quadratic_field_copy(&c1, input_isogeny_coefficients[1]);
+    quadratic_field_copy(&c2, input_isogeny_coefficients[2]);
+
+    // Two independent points per iteration, step by step
+    for (i = 0; i + 1 < input_number_of_points; i += 2) {
+        x_only_point_t *R = &input_output_points[i];
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&t0[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&t1[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].X, t0[j], c1); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].Z, t1[j], c2); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&t0[j], t0[j], t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&t0[j], c0, t0[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&t1[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&R[j].Z, R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_square(&t1[j], t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_square(&R[j].Z, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&R[j].X, t1[j], t0[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&t0[j], R[j].Z, t0[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].X, R[j].X, t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].Z, R[j].Z, t0[j]); }
+    }
+    if (i < input_number_of_points) {
+        x_only_4_isogeny_evaluation(&input_output_points[i], input_output_points[i], input_isogeny_coefficients);
+    }
+}
+
 void x_only_isogeny_from_kernel_alice(x_only_point_t *input_output_P,
                                       x_only_point_t *input_output_Q,
                                       x_only_point_t *input_output_P_minus_Q,
                                       projective_curve_alice_t *curve,
                                       x_only_point_t input_kernel) {
     quadratic_field_element_t isogeny_coefficients[3];
-    x_only_point_t R, strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE];
-    uint8_t i, row, strategy_step, index = 0, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE],
+    // P, Q, P - Q and the strategy points are contiguous, so each step pushes all of them with a single batch call (one
+    // extra slot carries R through the 2-isogeny)
+    x_only_point_t R, points[3 + STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE + 1], *strategy_points = &points[3];
+    uint8_t row, strategy_step, index = 0, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE],
             number_of_points = 0, strategy_position = 0;
 
+    x_only_point_copy(&points[0], *input_output_P);
+    x_only_point_copy(&points[1], *input_output_Q);
+    x_only_point_copy(&points[2], *input_output_P_minus_Q);
     x_only_point_copy(&R, input_kernel);
     index = 0;
 #if (EXPONENT_ALICE % 2 == 1)
@@ -117,13 +182,9 @@ void x_only_isogeny_from_kernel_alice(x_only_point_t *input_output_P,
                                     2,
                                     *curve);
     x_only_2_isogeny(curve, S);
-    for (i = 0; i < number_of_points; i++) {
-        x_only_2_isogeny_evaluation(&strategy_points[i], *&strategy_points[i], S);
-    }
-    x_only_2_isogeny_evaluation(input_output_P, *input_output_P, S);
-    x_only_2_isogeny_evaluation(input_output_Q, *input_output_Q, S);
-    x_only_2_isogeny_evaluation(input_output_P_minus_Q, *input_output_P_minus_Q, S);
-    x_only_2_isogeny_evaluation(&R, R, S);
+    x_only_point_copy(&strategy_points[number_of_points], R);
+    x_only_2_isogeny_evaluation_batch(points, 3 + number_of_points + 1, S);
+    x_only_point_copy(&R, strategy_points[number_of_points]);
 #endif
 
     // Composition of NUMBER_OF_ISOGENIES_ALICE consecutive 4-isogenies
@@ -139,12 +200,7 @@ void x_only_isogeny_from_kernel_alice(x_only_point_t *input_output_P,
             index += strategy_step;
         }
         x_only_4_isogeny(curve, isogeny_coefficients, R);
-        for (i = 0; i < number_of_points; i++) {
-            x_only_4_isogeny_evaluation(&strategy_points[i], strategy_points[i], isogeny_coefficients);
-        }
-        x_only_4_isogeny_evaluation(input_output_P, *input_output_P, isogeny_coefficients);
-        x_only_4_isogeny_evaluation(input_output_Q, *input_output_Q, isogeny_coefficients);
-        x_only_4_isogeny_evaluation(input_output_P_minus_Q, *input_output_P_minus_Q, isogeny_coefficients);
+        x_only_4_isogeny_evaluation_batch(points, 3 + number_of_points, isogeny_coefficients);
 
         x_only_point_copy(&R, strategy_points[number_of_points - 1]);
         index = strategy_indexes[number_of_points - 1];
@@ -152,17 +208,18 @@ void x_only_isogeny_from_kernel_alice(x_only_point_t *input_output_P,
     }
 
     x_only_4_isogeny(curve, isogeny_coefficients, R);
-    x_only_4_isogeny_evaluation(input_output_P, *input_output_P, isogeny_coefficients);
-    x_only_4_isogeny_evaluation(input_output_Q, *input_output_Q, isogeny_coefficients);
-    x_only_4_isogeny_evaluation(input_output_P_minus_Q, *input_output_P_minus_Q, isogeny_coefficients);
+    x_only_4_isogeny_evaluation_batch(points, 3, isogeny_coefficients);
+    x_only_point_copy(input_output_P, points[0]);
+    x_only_point_copy(input_output_Q, points[1]);
+    x_only_point_copy(input_output_P_minus_Q, points[2]);
 }
 
 void x_only_isogeny_from_kernel_curve_alice(projective_curve_alice_t *output_curve,
                                             x_only_point_t input_kernel,
                                             projective_curve_alice_t input_curve) {
     quadratic_field_element_t isogeny_coefficients[3];
-    x_only_point_t R, strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE];
-    uint8_t i, row, strategy_step, index, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE],
+    x_only_point_t R, strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE + 1];    // one extra slot for R
+    uint8_t row, strategy_step, index, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_ALICE],
             number_of_points = 0, strategy_position = 0;
 
     quadratic_field_copy(&output_curve->A_plus_2C, input_curve.A_plus_2C);
@@ -188,10 +245,9 @@ void x_only_isogeny_from_kernel_curve_alice(projective_curve_alice_t *output_cur
                                     2,
                                     *output_curve);
     x_only_2_isogeny(output_curve, S);
-    for (i = 0; i < number_of_points; i++) {
-        x_only_2_isogeny_evaluation(&strategy_points[i], *&strategy_points[i], S);
-    }
-    x_only_2_isogeny_evaluation(&R, R, S);
+    x_only_point_copy(&strategy_points[number_of_points], R);
+    x_only_2_isogeny_evaluation_batch(strategy_points, number_of_points + 1, S);
+    x_only_point_copy(&R, strategy_points[number_of_points]);
 #endif
 
     // Composition of NUMBER_OF_ISOGENIES_ALICE consecutive 4-isogenies
@@ -207,9 +263,7 @@ void x_only_isogeny_from_kernel_curve_alice(projective_curve_alice_t *output_cur
             index += strategy_step;
         }
         x_only_4_isogeny(output_curve, isogeny_coefficients, R);
-        for (i = 0; i < number_of_points; i++) {
-            x_only_4_isogeny_evaluation(&strategy_points[i], strategy_points[i], isogeny_coefficients);
-        }
+        x_only_4_isogeny_evaluation_batch(strategy_points, number_of_points, isogeny_coefficients);
 
         x_only_point_copy(&R, strategy_points[number_of_points - 1]);
         index = strategy_indexes[number_of_points - 1];
@@ -260,16 +314,48 @@ void x_only_3_isogeny_evaluation(x_only_point_t *output,
     quadratic_field_multiplication(&output->Z, input.Z, t0);
 }
 
+void x_only_3_isogeny_evaluation_batch(x_only_point_t *input_output_points,
+                                       int input_number_of_points,
+                                       const quadratic_field_element_t input_isogeny_coefficients[2]) {
+    int i, j;
+    quadratic_field_element_t c0, c1, t0[2], t1[2], t2[2];
+
+    quadratic_field_copy(&c0, input_isogeny_coefficients[0]);
+    quadratic_field_copy(&c1, input_isogeny_coefficients[1]);
+
+    // Two independent points per iteration, step by step
+    for (i = 0; i + 1 < input_number_of_points; i += 2) {
+        x_only_point_t *R = &input_output_points[i];
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&t0[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&t1[j], R[j].X, R[j].Z); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&t0[j], c0, t0[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&t1[j], c1, t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_addition(&t2[j], t0[j], t1[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_subtraction(&t0[j], t1[j], t0[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_square(&t2[j], t2[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_square(&t0[j], t0[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].X, R[j].X, t2[j]); }
+        for (j = 0; j < 2; j++) { quadratic_field_multiplication(&R[j].Z, R[j].Z, t0[j]); }
+    }
+    if (i < input_number_of_points) {
+        x_only_3_isogeny_evaluation(&input_output_points[i], input_output_points[i], input_isogeny_coefficients);
+    }
+}
+
 void x_only_isogeny_from_kernel_bob(x_only_point_t *input_output_P,
                                     x_only_point_t *input_output_Q,
                                     x_only_point_t *input_output_P_minus_Q,
                                     projective_curve_bob_t *input_output_curve,
                                     x_only_point_t input_kernel) {
     quadratic_field_element_t isogeny_coefficients[2];
-    x_only_point_t R, strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB];
-    uint8_t i, row, strategy_step, index = 0, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
+    // P, Q, P - Q and the strategy points are contiguous, so each step pushes all of them with a single batch call
+    x_only_point_t R, points[3 + STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB], *strategy_points = &points[3];
+    uint8_t row, strategy_step, index = 0, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
             number_of_points = 0, strategy_position = 0;
 
+    x_only_point_copy(&points[0], *input_output_P);
+    x_only_point_copy(&points[1], *input_output_Q);
+    x_only_point_copy(&points[2], *input_output_P_minus_Q);
     x_only_point_copy(&R, input_kernel);
 
     // Composition of NUMBER_OF_ISOGENIES_ALICE consecutive 3-isogenies
@@ -286,12 +372,7 @@ void x_only_isogeny_from_kernel_bob(x_only_point_t *input_output_P,
             index += strategy_step;
         }
         x_only_3_isogeny(input_output_curve, isogeny_coefficients, R);
-        for (i = 0; i < number_of_points; i++) {
-            x_only_3_isogeny_evaluation(&strategy_points[i], strategy_points[i], isogeny_coefficients);
-        }
-        x_only_3_isogeny_evaluation(input_output_P, *input_output_P, isogeny_coefficients);
-        x_only_3_isogeny_evaluation(input_output_Q, *input_output_Q, isogeny_coefficients);
-        x_only_3_isogeny_evaluation(input_output_P_minus_Q, *input_output_P_minus_Q, isogeny_coefficients);
+        x_only_3_isogeny_evaluation_batch(points, 3 + number_of_points, isogeny_coefficients);
 
         x_only_point_copy(&R, strategy_points[number_of_points - 1]);
         index = strategy_indexes[number_of_points - 1];
@@ -299,9 +380,10 @@ void x_only_isogeny_from_kernel_bob(x_only_point_t *input_output_P,
     }
 
     x_only_3_isogeny(input_output_curve, isogeny_coefficients, R);
-    x_only_3_isogeny_evaluation(input_output_P, *input_output_P, isogeny_coefficients);
-    x_only_3_isogeny_evaluation(input_output_Q, *input_output_Q, isogeny_coefficients);
-    x_only_3_isogeny_evaluation(input_output_P_minus_Q, *input_output_P_minus_Q, isogeny_coefficients);
+    x_only_3_isogeny_evaluation_batch(points, 3, isogeny_coefficients);
+    x_only_point_copy(input_output_P, points[0]);
+    x_only_point_copy(input_output_Q, points[1]);
+    x_only_point_copy(input_output_P_minus_Q, points[2]);
 }
 
 void x_only_isogeny_from_kernel_curve_bob(projective_curve_bob_t *output_curve,
@@ -309,7 +391,7 @@ void x_only_isogeny_from_kernel_curve_bob(projective_curve_bob_t *output_curve,
                                           projective_curve_bob_t input_curve) {
     quadratic_field_element_t isogeny_coefficients[2];
     x_only_point_t R, strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB];
-    uint8_t i, row, strategy_step, index = 0, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
+    uint8_t row, strategy_step, index = 0, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
             number_of_points = 0, strategy_position = 0;
 
     quadratic_field_copy(&output_curve->A_plus_2C, input_curve.A_plus_2C);
@@ -330,9 +412,7 @@ void x_only_isogeny_from_kernel_curve_bob(projective_curve_bob_t *output_curve,
             index += strategy_step;
         }
         x_only_3_isogeny(output_curve, isogeny_coefficients, R);
-        for (i = 0; i < number_of_points; i++) {
-            x_only_3_isogeny_evaluation(&strategy_points[i], strategy_points[i], isogeny_coefficients);
-        }
+        x_only_3_isogeny_evaluation_batch(strategy_points, number_of_points, isogeny_coefficients);
 
         x_only_point_copy(&R, strategy_points[number_of_points - 1]);
         index = strategy_indexes[number_of_points - 1];
@@ -347,10 +427,12 @@ void x_only_isogeny_from_kernel_point_and_curve_bob(x_only_point_t *input_output
                                                     projective_curve_bob_t *input_output_curve,
                                                     x_only_point_t input_kernel) {
     quadratic_field_element_t isogeny_coefficients[2];
-    x_only_point_t R, strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB];
-    uint8_t i, row, strategy_step, index, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
+    x_only_point_t R, points[2 + STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB], *strategy_points = &points[2];
+    uint8_t row, strategy_step, index, strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
             number_of_points = 0, strategy_position = 0;
 
+    x_only_point_copy(&points[0], *input_output_P);
+    x_only_point_copy(&points[1], *input_output_R);
     x_only_point_copy(&R, input_kernel);
 
     // Composition of NUMBER_OF_ISOGENIES_ALICE consecutive 3-isogenies
@@ -367,12 +449,7 @@ void x_only_isogeny_from_kernel_point_and_curve_bob(x_only_point_t *input_output
             index += strategy_step;
         }
         x_only_3_isogeny(input_output_curve, isogeny_coefficients, R);
-        for (i = 0; i < number_of_points; i++) {
-            x_only_3_isogeny_evaluation(&strategy_points[i], strategy_points[i], isogeny_coefficients);
-        }
-
-        x_only_3_isogeny_evaluation(input_output_P, *input_output_P, isogeny_coefficients);
-        x_only_3_isogeny_evaluation(input_output_R, *input_output_R, isogeny_coefficients);
+        x_only_3_isogeny_evaluation_batch(points, 2 + number_of_points, isogeny_coefficients);
 
         x_only_point_copy(&R, strategy_points[number_of_points - 1]);
         index = strategy_indexes[number_of_points - 1];
@@ -380,6 +457,7 @@ void x_only_isogeny_from_kernel_point_and_curve_bob(x_only_point_t *input_output
     }
 
     x_only_3_isogeny(input_output_curve, isogeny_coefficients, R);
-    x_only_3_isogeny_evaluation(input_output_P, *input_output_P, isogeny_coefficients);
-    x_only_3_isogeny_evaluation(input_output_R, *input_output_R, isogeny_coefficients);
+    x_only_3_isogeny_evaluation_batch(points, 2, isogeny_coefficients);
+    x_only_point_copy(input_output_P, points[0]);
+    x_only_point_copy(input_output_R, points[1]);
 }
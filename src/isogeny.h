@@ -20,6 +20,11 @@ void x_only_2_isogeny(projective_curve_alice_t *output_curve, x_only_point_t inp
 
 void x_only_2_isogeny_evaluation(x_only_point_t *output, x_only_point_t input, x_only_point_t input_kernel);
 
+// In-place evaluation of an array of points, two independent points at a time
+void x_only_2_isogeny_evaluation_batch(x_only_point_t *input_output_points,
+                                       int input_number_of_points,
+                                       x_only_point_t input_kernel);
+
 #endif
 
 void x_only_4_isogeny(projective_curve_alice_t *output_curve,
@@ -30,6 +35,11 @@ void x_only_4_isogeny_evaluation(x_only_point_t *output,
                                  x_only_point_t input,
                                  const quadratic_field_element_t input_isogeny_coefficients[3]);
 
+// In-place evaluation of an array of points, two independent points at a time
+void x_only_4_isogeny_evaluation_batch(x_only_point_t *input_output_points,
+                                       int input_number_of_points,
+                                       const quadratic_field_element_t input_isogeny_coefficients[3]);
+
 void x_only_isogeny_from_kernel_alice(x_only_point_t *input_output_P,
                                       x_only_point_t *input_output_Q,
                                       x_only_point_t *input_output_P_minus_Q,
@@ -55,6 +65,11 @@ void x_only_3_isogeny_evaluation(x_only_point_t *output,
                                  x_only_point_t input,
                                  const quadratic_field_element_t input_isogeny_coefficients[2]);
 
+// In-place evaluation of an array of points, two independent points at a time
+void x_only_3_isogeny_evaluation_batch(x_only_point_t *input_output_points,
+                                       int input_number_of_points,
+                                       const quadratic_field_element_t input_isogeny_coefficients[2]);
+
 void x_only_isogeny_from_kernel_bob(x_only_point_t *input_output_P,
                                     x_only_point_t *input_output_Q,
                                     x_only_point_t *input_output_P_minus_Q,
@@ -0,0 +1,160 @@
+//
+// Read-only, memory-mapped store of prepared public keys
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "key_store.h"
+
+#define KEY_STORE_FLAG_ASM 1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t field_bits;
+    uint32_t record_bytes;
+    uint32_t flags;
+    uint64_t number_of_keys;
+    uint8_t reserved[KEY_STORE_HEADER_BYTES - 32];
+} key_store_header_t;
+
+struct sidh_key_store {
+    void *map;
+    size_t map_bytes;
+    const sidh_prepared_public_key_t *keys;
+    uint64_t number_of_keys;
+};
+
+static void key_store_header(key_store_header_t *header, uint64_t number_of_keys) {
+    memset(header, 0, sizeof(key_store_header_t));
+    memcpy(header->magic, KEY_STORE_MAGIC, sizeof(header->magic));
+    header->version = KEY_STORE_VERSION;
+    header->field_bits = FIELD_BITS;
+    header->record_bytes = sizeof(sidh_prepared_public_key_t);
+#ifdef QUADRATIC_FIELD_ASM
+    header->flags = KEY_STORE_FLAG_ASM;
+#endif
+    header->number_of_keys = number_of_keys;
+}
+
+static int key_store_compare(const void *a, const void *b) {
+    return memcmp(((const sidh_prepared_public_key_t *) a)->public_key,
+                  ((const sidh_prepared_public_key_t *) b)->public_key,
+                  PUBLIC_KEY_BYTES);
+}
+
+uint8_t sidh_key_store_write(const char *path, const uint8_t *public_keys, uint64_t number_of_keys) {
+    sidh_prepared_public_key_t *keys;
+    key_store_header_t header;
+    uint64_t i, unique = 0;
+    size_t path_length = strlen(path);
+    char *temporary_path;
+    FILE *file;
+    uint8_t returned_value = EXIT_FAILURE;
+
+    keys = calloc(number_of_keys > 0 ? number_of_keys : 1, sizeof(sidh_prepared_public_key_t));
+    temporary_path = malloc(path_length + 5);
+    if (keys == NULL || temporary_path == NULL) { goto end; }
+
+    for (i = 0; i < number_of_keys; i++) {
+        sidh_signature_prepare_public_key(&keys[i], &public_keys[PUBLIC_KEY_BYTES * i]);
+    }
+    qsort(keys, number_of_keys, sizeof(sidh_prepared_public_key_t), key_store_compare);
+    for (i = 0; i < number_of_keys; i++) {
+        if (unique == 0 || key_store_compare(&keys[unique - 1], &keys[i]) != 0) { keys[unique++] = keys[i]; }
+    }
+    key_store_header(&header, unique);
+
+    // Readers never see a partial store
+    memcpy(temporary_path, path, path_length);
+    memcpy(&temporary_path[path_length], ".tmp", 5);
+    file = fopen(temporary_path, "wb");
+    if (file == NULL) { goto end; }
+    if (fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(keys, sizeof(sidh_prepared_public_key_t), unique, file) == unique &&
+        fflush(file) == 0 && fsync(fileno(file)) == 0) {
+        returned_value = EXIT_SUCCESS;
+    }
+    if (fclose(file) != 0) { returned_value = EXIT_FAILURE; }
+    if (returned_value == EXIT_SUCCESS && rename(temporary_path, path) != 0) { returned_value = EXIT_FAILURE; }
+    if (returned_value == EXIT_FAILURE) { unlink(temporary_path); }
+
+    end:
+    free(temporary_path);
+    free(keys);
+    return returned_value;
+}
+
+sidh_key_store_t *sidh_key_store_open(const char *path) {
+    key_store_header_t expected;
+    const key_store_header_t *header;
+    sidh_key_store_t *store;
+    struct stat status;
+    void *map;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) { return NULL; }
+    if (fstat(fd, &status) != 0 || (size_t) status.st_size < sizeof(key_store_header_t)) {
+        close(fd);
+        return NULL;
+    }
+    map = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { return NULL; }
+
+    header = (const key_store_header_t *) map;
+    key_store_header(&expected, header->number_of_keys);
+    if (memcmp(header, &expected, sizeof(key_store_header_t)) != 0 ||
+        header->number_of_keys > ((size_t) status.st_size - sizeof(key_store_header_t)) /
+                                  sizeof(sidh_prepared_public_key_t) ||
+        (size_t) status.st_size !=
+        sizeof(key_store_header_t) + (header->number_of_keys * sizeof(sidh_prepared_public_key_t))) {
+        munmap(map, (size_t) status.st_size);
+        return NULL;
+    }
+
+    store = malloc(sizeof(sidh_key_store_t));
+    if (store == NULL) {
+        munmap(map, (size_t) status.st_size);
+        return NULL;
+    }
+    store->map = map;
+    store->map_bytes = (size_t) status.st_size;
+    store->keys = (const sidh_prepared_public_key_t *) &((const uint8_t *) map)[sizeof(key_store_header_t)];
+    store->number_of_keys = header->number_of_keys;
+    return store;
+}
+
+void sidh_key_store_close(sidh_key_store_t *store) {
+    if (store == NULL) { return; }
+    munmap(store->map, store->map_bytes);
+    free(store);
+}
+
+uint64_t sidh_key_store_size(const sidh_key_store_t *store) {
+    return store->number_of_keys;
+}
+
+const sidh_prepared_public_key_t *sidh_key_store_get(const sidh_key_store_t *store, uint64_t index) {
+    return (index < store->number_of_keys) ? &store->keys[index] : NULL;
+}
+
+const sidh_prepared_public_key_t *sidh_key_store_find(const sidh_key_store_t *store,
+                                                      const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint64_t low = 0, high = store->number_of_keys, middle;
+    int comparison;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        comparison = memcmp(store->keys[middle].public_key, public_key, PUBLIC_KEY_BYTES);
+        if (comparison == 0) { return &store->keys[middle]; }
+        if (comparison < 0) { low = middle + 1; } else { high = middle; }
+    }
+    return NULL;
+}
@@ -0,0 +1,36 @@
+//
+// Read-only, memory-mapped store of prepared public keys
+//
+
+#ifndef SIDH_POK_KEY_STORE_H
+#define SIDH_POK_KEY_STORE_H
+
+#include "signature.h"
+
+// File layout: a KEY_STORE_HEADER_BYTES header, then the sidh_prepared_public_key_t records sorted by public key.
+// Records are stored as laid out in memory, so a store is only opened by builds with the same prime, field
+// backend and record size, which the header records
+#define KEY_STORE_MAGIC         "SIDHKEYS"
+#define KEY_STORE_VERSION       1
+#define KEY_STORE_HEADER_BYTES  64
+
+typedef struct sidh_key_store sidh_key_store_t;
+
+// Prepares and validates every key; invalid keys are stored too, with valid = 0. Duplicates are kept once
+uint8_t sidh_key_store_write(const char *path, const uint8_t *public_keys, uint64_t number_of_keys);
+
+// Maps the file read-only and shared, so that processes opening the same store share its pages
+sidh_key_store_t *sidh_key_store_open(const char *path);
+
+void sidh_key_store_close(sidh_key_store_t *store);
+
+uint64_t sidh_key_store_size(const sidh_key_store_t *store);
+
+// NULL when out of range
+const sidh_prepared_public_key_t *sidh_key_store_get(const sidh_key_store_t *store, uint64_t index);
+
+// Binary search on the public key bytes; NULL when absent
+const sidh_prepared_public_key_t *sidh_key_store_find(const sidh_key_store_t *store,
+                                                      const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+#endif //SIDH_POK_KEY_STORE_H
@@ -7,17 +7,15 @@
 #include <string.h>
 #include "pok.h"
 #include "utilities.h"
+#ifdef PARALLEL_BRANCHES
+#include <pthread.h>
+#endif
 
 // Most Significant Byte determines the shape of the kernel: either P + [t3ᵇ⁻¹ + k]Q or [3k]P + Q where t in {0,1,2}
 void random_private_key_sample(uint8_t output[SECRET_KEY_BYTES_BOB + 1], keccak_state *state) {
     // We should move computation of max into a global variable
-    uint64_t max[SUBGROUP_ORDER_64BITS_WORDS] = {0}, t[SUBGROUP_ORDER_64BITS_WORDS];
-    max[0] = 1;
-    for (int i = 1; i < EXPONENT_BOB; i++) {
-        memcpy(t, max, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
-        multiprecision_shift_to_left(max, SUBGROUP_ORDER_64BITS_WORDS);
-        multiprecision_addition(max, max, t, SUBGROUP_ORDER_64BITS_WORDS);
-    }
+    uint64_t max[SUBGROUP_ORDER_64BITS_WORDS], t[SUBGROUP_ORDER_64BITS_WORDS];
+    scalar_power_of_three(max, EXPONENT_BOB - 1);
 
     shake256_squeeze((uint8_t *) output, SECRET_KEY_BYTES_BOB + 1, state);
     output[SECRET_KEY_BYTES_BOB - 1] &= MASK_BOB;
@@ -32,15 +30,23 @@ void random_private_key_sample(uint8_t output[SECRET_KEY_BYTES_BOB + 1], keccak_
     }
 }
 
-uint8_t canonical_basis(sidh_public_key_t *output_basis, quadratic_field_element_t input_A) {
+uint8_t canonical_basis_projective(x_only_point_t *output_P,
+                                   x_only_point_t *output_Q,
+                                   x_only_point_t *output_P_minus_Q,
+                                   quadratic_field_element_t input_A) {
     quadratic_field_element_t u;
-    x_only_point_t P, Q, P_minus_Q;
 
     // u = 1 + i
     prime_field_set_to_one(u.re);
     prime_field_set_to_one(u.im);
 
-    if(x_only_canonical_basis_bob(&P, &Q, &P_minus_Q, u, input_A) == EXIT_FAILURE) { return EXIT_FAILURE; }
+    return x_only_canonical_basis_bob(output_P, output_Q, output_P_minus_Q, u, input_A);
+}
+
+uint8_t canonical_basis(sidh_public_key_t *output_basis, quadratic_field_element_t input_A) {
+    x_only_point_t P, Q, P_minus_Q;
+
+    if(canonical_basis_projective(&P, &Q, &P_minus_Q, input_A) == EXIT_FAILURE) { return EXIT_FAILURE; }
 
     simultaneous_three_inverses(&P.Z, &Q.Z, &P_minus_Q.Z);
     quadratic_field_multiplication(&output_basis->P, P.X, P.Z);
@@ -49,16 +55,13 @@ uint8_t canonical_basis(sidh_public_key_t *output_basis, quadratic_field_element
     return EXIT_SUCCESS;
 }
 
-uint8_t decomposition_by_scalars(scalar_t output_c,
-                                 scalar_t output_d,
-                                 quadratic_field_element_t input_kernel,
-                                 sidh_public_key_t input_basis,
-                                 quadratic_field_element_t input_A) {
+// y-coordinate of P as a square-root of x³ + Ax² + x, and the one of Q as (Y:Z) such that it agrees with x(P - Q)
+static uint8_t to_twisted_edwards_basis(projective_point_t *output_P,
+                                        projective_point_t *output_Q,
+                                        sidh_public_key_t input_basis,
+                                        quadratic_field_element_t input_A) {
     uint8_t ret;
-    quadratic_field_element_t yP, yQ, zQ, t, yK;
-
-    projective_point_t P_twisted_edwards, Q_twisted_edwards, K_twisted_edwards;
-    twisted_edwards_curve_t curve;
+    quadratic_field_element_t yP, yQ, zQ, t;
 
     // +++++++ y-coordinate of P
     // square-root of x³ + Ax² + x
@@ -79,6 +82,37 @@ uint8_t decomposition_by_scalars(scalar_t output_c,
                                      input_basis.P_minus_Q,
                                      input_A);
 
+    to_twisted_edwards_model(output_P, input_basis.P, yP);
+    to_twisted_edwards_model_mixed(output_Q, input_basis.Q, yQ, zQ);
+    return EXIT_SUCCESS;
+}
+
+// To Twisted Edwards model by setting a = A + 2 and d = A - 2
+static void to_twisted_edwards_curve(twisted_edwards_curve_t *output, quadratic_field_element_t input_A) {
+    quadratic_field_copy(&output->a, input_A);
+    prime_field_addition(output->a.re, output->a.re, MONTGOMERY_CONSTANT_ONE);
+    prime_field_addition(output->a.re, output->a.re, MONTGOMERY_CONSTANT_ONE);
+    quadratic_field_copy(&output->d, input_A);
+    prime_field_subtraction(output->d.re, output->d.re, MONTGOMERY_CONSTANT_ONE);
+    prime_field_subtraction(output->d.re, output->d.re, MONTGOMERY_CONSTANT_ONE);
+}
+
+uint8_t decomposition_by_scalars(scalar_t output_c,
+                                 scalar_t output_d,
+                                 quadratic_field_element_t input_kernel,
+                                 sidh_public_key_t input_basis,
+                                 quadratic_field_element_t input_A,
+                                 projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]) {
+    uint8_t ret;
+    quadratic_field_element_t t, yK;
+
+    projective_point_t P_twisted_edwards, Q_twisted_edwards, K_twisted_edwards;
+    twisted_edwards_curve_t curve;
+
+    if (to_twisted_edwards_basis(&P_twisted_edwards, &Q_twisted_edwards, input_basis, input_A) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+
     // +++++++  y-coordinate of the kernel
     // square-root of x³ + Ax² + x
     quadratic_field_square(&t, input_kernel);
@@ -89,31 +123,60 @@ uint8_t decomposition_by_scalars(scalar_t output_c,
     ret = quadratic_field_is_square(&yK, yK);
     if (!ret) { return EXIT_FAILURE; }
 
-    to_twisted_edwards_model(&P_twisted_edwards, input_basis.P, yP);
-    to_twisted_edwards_model_mixed(&Q_twisted_edwards, input_basis.Q, yQ, zQ);
     to_twisted_edwards_model(&K_twisted_edwards, input_kernel, yK);
-
-    // To Twisted Edwards model by setting a = A + 2 and d = A - 2
-    quadratic_field_copy(&curve.a, input_A);
-    prime_field_addition(curve.a.re, curve.a.re, MONTGOMERY_CONSTANT_ONE);
-    prime_field_addition(curve.a.re, curve.a.re, MONTGOMERY_CONSTANT_ONE);
-    quadratic_field_copy(&curve.d, input_A);
-    prime_field_subtraction(curve.d.re, curve.d.re, MONTGOMERY_CONSTANT_ONE);
-    prime_field_subtraction(curve.d.re, curve.d.re, MONTGOMERY_CONSTANT_ONE);
-
-    two_dimensional_pohlig_hellman_bob(output_c,
-                                       output_d,
-                                       K_twisted_edwards,
-                                       P_twisted_edwards,
-                                       Q_twisted_edwards,
-                                       curve);
+    to_twisted_edwards_curve(&curve, input_A);
+
+    two_dimensional_pohlig_hellman_bob_workspace(output_c,
+                                                 output_d,
+                                                 K_twisted_edwards,
+                                                 P_twisted_edwards,
+                                                 Q_twisted_edwards,
+                                                 curve,
+                                                 workspace);
     return EXIT_SUCCESS;
 }
 
-uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
-                            uint8_t insight[INSIGHT_BYTES],
-                            const uint8_t private_key_alice[SECRET_KEY_BYTES_ALICE],
-                            keccak_state *state) {
+// Independent branches of a round: with PARALLEL_BRANCHES, the second one runs on a helper thread while the calling
+// thread runs the first one; if the helper fails to start, or without the option, both run here in order
+static void pok_fork_join(void *(*first)(void *), void *first_argument, void *(*second)(void *), void *second_argument) {
+#ifdef PARALLEL_BRANCHES
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, second, second_argument) == 0) {
+        first(first_argument);
+        pthread_join(thread, NULL);
+        return;
+    }
+#endif
+    first(first_argument);
+    second(second_argument);
+}
+
+typedef struct {
+    x_only_point_t *output;
+    quadratic_field_element_t P, Q, P_minus_Q;
+    const uint64_t *scalar;
+    int bits;
+    quadratic_field_element_t A;
+} pok_ladder_branch_t;
+
+static void *pok_ladder_branch(void *argument) {
+    pok_ladder_branch_t *branch = (pok_ladder_branch_t *) argument;
+
+    x_only_three_point_ladder(branch->output,
+                              branch->P,
+                              branch->Q,
+                              branch->P_minus_Q,
+                              branch->scalar,
+                              branch->bits,
+                              branch->A);
+    return NULL;
+}
+
+uint8_t sidh_pok_commitment_insight(uint8_t commit[COMMITMENT_BYTES],
+                                    sidh_pok_insight_t *insight,
+                                    const uint8_t private_key_alice[SECRET_KEY_BYTES_ALICE],
+                                    keccak_state *state) {
     sidh_private_key_t private_key, ephemeral_key, ephemeral_key_3;
     x_only_point_t P0, Q0, P0_minus_Q0, // Public points: either {PA, QA, PA-QA} or {PB, QB, PB-QB}
     K_phi, K_psi, K_psi_dual;           // kernel generators
@@ -121,6 +184,7 @@ uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
     projective_curve_alice_t curve_alice;
     projective_curve_bob_t curve_bob;
     sidh_public_key_t public_key;
+    pok_ladder_branch_t ladder_psi, ladder_phi;
     uint8_t ephemeral_key_bytes[SECRET_KEY_BYTES_BOB + 1];
 
     private_key.key[SUBGROUP_ORDER_64BITS_WORDS - 1] = 0;
@@ -143,13 +207,8 @@ uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
                             SUBGROUP_ORDER_64BITS_WORDS);
 
     // +++++++ Look at this, we also need it here (we need to move it as a global variable?)
-    uint64_t max[SUBGROUP_ORDER_64BITS_WORDS] = {0}, t[SUBGROUP_ORDER_64BITS_WORDS];
-    max[0] = 1;
-    for (int i = 1; i < EXPONENT_BOB; i++) {
-        memcpy(t, max, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
-        multiprecision_shift_to_left(max, SUBGROUP_ORDER_64BITS_WORDS);
-        multiprecision_addition(max, max, t, SUBGROUP_ORDER_64BITS_WORDS);
-    }
+    uint64_t max[SUBGROUP_ORDER_64BITS_WORDS], t[SUBGROUP_ORDER_64BITS_WORDS];
+    scalar_power_of_three(max, EXPONENT_BOB - 1);
     // Linear pass to get the right scalar and swapping of points [CHECK THE NEXT CONDITIONAL MOVS]
     // 3ᵇ⁻¹ + k
     multiprecision_addition(t, max, ephemeral_key.key, SUBGROUP_ORDER_64BITS_WORDS);
@@ -179,25 +238,14 @@ uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
     quadratic_field_addition(&A, u, A); // 3
     quadratic_field_addition(&A, A, A); // 6
     // order-3ᵇ kernel point generator of ker ψ (secret kernel point computation)
-    x_only_three_point_ladder(&K_psi,
-                              P0.X,
-                              Q0.X,
-                              P0_minus_Q0.X,
-                              ephemeral_key.key,
-                              SUBGROUP_ORDER_BITS_BOB,
-                              A);
+    ladder_psi = (pok_ladder_branch_t) {&K_psi, P0.X, Q0.X, P0_minus_Q0.X, ephemeral_key.key, SUBGROUP_ORDER_BITS_BOB, A};
     // order-2ᵃ kernel point generator of ker φ (secret kernel point computation)
     initialize_basis(&P0.X, &Q0.X, &P0_minus_Q0.X, PUBLIC_POINT_GENERATORS_ALICE);
     quadratic_field_set_to_one(&P0.Z);
     quadratic_field_set_to_one(&Q0.Z);
     quadratic_field_set_to_one(&P0_minus_Q0.Z);
-    x_only_three_point_ladder(&K_phi,
-                              P0.X,
-                              Q0.X,
-                              P0_minus_Q0.X,
-                              private_key.key,
-                              SUBGROUP_ORDER_BITS_ALICE,
-                              A);
+    ladder_phi = (pok_ladder_branch_t) {&K_phi, P0.X, Q0.X, P0_minus_Q0.X, private_key.key, SUBGROUP_ORDER_BITS_ALICE, A};
+    pok_fork_join(pok_ladder_branch, &ladder_psi, pok_ladder_branch, &ladder_phi);
     // Computation of E₂ and ker φ' = ψ (ker φ)
     to_projective_curve_bob(&curve_bob, A);
     x_only_isogeny_from_kernel_point_and_curve_bob(&K_phi,
@@ -208,18 +256,21 @@ uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
     quadratic_field_multiplication(&u, K_phi.Z, K_psi_dual.Z);
     quadratic_field_inverse(&u, u);
     quadratic_field_multiplication(&z, K_psi_dual.Z, u);
-    quadratic_field_multiplication(&z, K_phi.X, z);
-    quadratic_field_element_to_bytes(insight, z);                            // ker φ
+    quadratic_field_multiplication(&insight->K_phi, K_phi.X, z);            // ker φ
     quadratic_field_multiplication(&z, K_phi.Z, u);
-    quadratic_field_multiplication(&z, K_psi_dual.X, z);
-    quadratic_field_element_to_bytes(&insight[QUADRATIC_FIELD_BYTES], z);    // ker (dual of ψ)
+    quadratic_field_multiplication(&insight->K_psi_dual, K_psi_dual.X, z);  // ker (dual of ψ)
 
     from_projective_curve_bob(&A, curve_bob);
     quadratic_field_element_to_bytes(commit, A);
-    quadratic_field_element_to_bytes(&insight[2 * QUADRATIC_FIELD_BYTES], A);
+    quadratic_field_copy(&insight->A, A);
     // Looking for P₂, Q₂, and (P₂ - Q₂)
-    if(canonical_basis(&public_key, A) == EXIT_FAILURE) { return EXIT_FAILURE; }
-    sidh_public_key_to_bytes(&insight[3 * QUADRATIC_FIELD_BYTES], &public_key);
+    if(canonical_basis(&public_key, A) == EXIT_FAILURE) {
+        // Nothing of a failed commitment is usable, and the insight holds secret kernels
+        memset(commit, 0, COMMITMENT_BYTES);
+        memset(insight, 0, sizeof(sidh_pok_insight_t));
+        return EXIT_FAILURE;
+    }
+    insight->basis = public_key;
     quadratic_field_copy(&P0.X, public_key.P);
     quadratic_field_set_to_one(&P0.Z);
     quadratic_field_copy(&Q0.X, public_key.Q);
@@ -241,6 +292,33 @@ uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
     return EXIT_SUCCESS;
 }
 
+void sidh_pok_insight_to_bytes(uint8_t insight_bytes[INSIGHT_BYTES], const sidh_pok_insight_t *insight) {
+    quadratic_field_element_to_bytes(insight_bytes, insight->K_phi);
+    quadratic_field_element_to_bytes(&insight_bytes[QUADRATIC_FIELD_BYTES], insight->K_psi_dual);
+    quadratic_field_element_to_bytes(&insight_bytes[2 * QUADRATIC_FIELD_BYTES], insight->A);
+    sidh_public_key_to_bytes(&insight_bytes[3 * QUADRATIC_FIELD_BYTES], &insight->basis);
+}
+
+void sidh_pok_insight_from_bytes(sidh_pok_insight_t *insight, const uint8_t insight_bytes[INSIGHT_BYTES]) {
+    quadratic_field_element_from_bytes(&insight->K_phi, insight_bytes);
+    quadratic_field_element_from_bytes(&insight->K_psi_dual, &insight_bytes[QUADRATIC_FIELD_BYTES]);
+    quadratic_field_element_from_bytes(&insight->A, &insight_bytes[2 * QUADRATIC_FIELD_BYTES]);
+    sidh_public_key_from_bytes(&insight->basis, &insight_bytes[3 * QUADRATIC_FIELD_BYTES]);
+}
+
+uint8_t sidh_pok_commitment(uint8_t commit[COMMITMENT_BYTES],
+                            uint8_t insight[INSIGHT_BYTES],
+                            const uint8_t private_key_alice[SECRET_KEY_BYTES_ALICE],
+                            keccak_state *state) {
+    sidh_pok_insight_t insight_montgomery;
+    if (sidh_pok_commitment_insight(commit, &insight_montgomery, private_key_alice, state) == EXIT_FAILURE) {
+        memset(insight, 0, INSIGHT_BYTES);
+        return EXIT_FAILURE;
+    }
+    sidh_pok_insight_to_bytes(insight, &insight_montgomery);
+    return EXIT_SUCCESS;
+}
+
 void sidh_pok_challenge(uint8_t *challenge, const uint8_t *commitment, uint64_t commitment_size,
                         const uint8_t *statement, uint64_t statement_size) {
     uint8_t separator = 0xFF;
@@ -255,90 +333,255 @@ void sidh_pok_challenge(uint8_t *challenge, const uint8_t *commitment, uint64_t
 }
 
 
-uint8_t sidh_pok_response(uint8_t resp[RESPONSE_BYTES], const uint8_t insight[INSIGHT_BYTES], uint8_t challenge) {
+uint8_t sidh_pok_response_insight(uint8_t resp[RESPONSE_BYTES],
+                                  const sidh_pok_insight_t *insight,
+                                  uint8_t challenge,
+                                  projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]) {
     memset(resp, 0, RESPONSE_BYTES);
     if (!challenge) {
         // challenge = 0
-        quadratic_field_element_t K_psi_dual, A;
-        sidh_public_key_t basis;
-        quadratic_field_element_from_bytes(&K_psi_dual, &insight[QUADRATIC_FIELD_BYTES]);
-        quadratic_field_element_from_bytes(&A, &insight[2 * QUADRATIC_FIELD_BYTES]);
-        sidh_public_key_from_bytes(&basis, &insight[3 * QUADRATIC_FIELD_BYTES]);
         scalar_t c = {0}, d = {0};
         uint8_t success = decomposition_by_scalars(c,
                                                    d,
-                                                   K_psi_dual,
-                                                   basis,
-                                                   A);
+                                                   insight->K_psi_dual,
+                                                   insight->basis,
+                                                   insight->A,
+                                                   workspace);
         if (success == EXIT_FAILURE) { return EXIT_FAILURE; }
         memcpy(resp, (const uint8_t *) c, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
         memcpy(&resp[FIELD_BYTES], (const uint8_t *) d, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
         return EXIT_SUCCESS;
     } else {
+        quadratic_field_element_to_bytes(resp, insight->K_phi);
+        return EXIT_SUCCESS;
+    }
+}
+
+uint8_t sidh_pok_response_workspace(uint8_t resp[RESPONSE_BYTES],
+                                    const uint8_t insight[INSIGHT_BYTES],
+                                    uint8_t challenge,
+                                    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]) {
+    if (challenge) {
         memcpy(resp, insight, RESPONSE_BYTES);
         return EXIT_SUCCESS;
     }
+    sidh_pok_insight_t insight_montgomery;
+    sidh_pok_insight_from_bytes(&insight_montgomery, insight);
+    return sidh_pok_response_insight(resp, &insight_montgomery, challenge, workspace);
+}
+
+uint8_t sidh_pok_response(uint8_t resp[RESPONSE_BYTES], const uint8_t insight[INSIGHT_BYTES], uint8_t challenge) {
+    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS];
+    return sidh_pok_response_workspace(resp, insight, challenge, workspace);
+}
+
+uint8_t sidh_pok_commitment_recovery(uint8_t commit[COMMITMENT_BYTES], const uint8_t resp[RESPONSE_BYTES]) {
+    sidh_public_key_t basis2, basis3;
+    quadratic_field_element_t E2;
+    x_only_point_t K_phi_prime, T, R, R_minus_T;
+    projective_curve_alice_t curve2;
+
+    // Only E₂ is read from the commitment: {P₃, Q₃, P₃-Q₃} are recomputed as φ'(P₂), φ'(Q₂), and φ'(P₂ - Q₂)
+    quadratic_field_element_from_bytes(&E2, commit);
+    if (canonical_basis(&basis2, E2) == EXIT_FAILURE) { return EXIT_FAILURE; }
+
+    to_projective_curve_alice(&curve2, E2);
+    quadratic_field_element_from_bytes(&K_phi_prime.X, resp);
+    quadratic_field_set_to_one(&K_phi_prime.Z);
+
+    x_only_multiple_point_doublings(&T, K_phi_prime, EXPONENT_ALICE - 1, curve2);
+    x_only_point_doubling(&R, T, curve2);
+    if (!x_only_point_is_infinity(R) || x_only_point_is_infinity(T)) { return EXIT_FAILURE; }    // full-order?
+
+    quadratic_field_copy(&R.X, basis2.P);
+    quadratic_field_set_to_one(&R.Z);
+    quadratic_field_copy(&T.X, basis2.Q);
+    quadratic_field_set_to_one(&T.Z);
+    quadratic_field_copy(&R_minus_T.X, basis2.P_minus_Q);
+    quadratic_field_set_to_one(&R_minus_T.Z);
+    x_only_isogeny_from_kernel_alice(&R,
+                                     &T,
+                                     &R_minus_T,
+                                     &curve2,
+                                     K_phi_prime);
+    simultaneous_three_inverses(&R.Z, &T.Z, &R_minus_T.Z);
+    quadratic_field_multiplication(&basis3.P, R.X, R.Z);
+    quadratic_field_multiplication(&basis3.Q, T.X, T.Z);
+    quadratic_field_multiplication(&basis3.P_minus_Q, R_minus_T.X, R_minus_T.Z);
+    sidh_public_key_to_bytes(&commit[QUADRATIC_FIELD_BYTES], &basis3);
+    return EXIT_SUCCESS;
 }
 
 uint8_t sidh_pok_verification(const uint8_t commit[COMMITMENT_BYTES],
                               const uint8_t resp[RESPONSE_BYTES],
                               const uint8_t public_key_alice[PUBLIC_KEY_BYTES],
                               uint8_t challenge) {
-    sidh_public_key_t basis1, basis2, basis3;
-    quadratic_field_element_t E0, E1, E2, E3, t;
+    sidh_public_key_t basis1;
+    quadratic_field_element_t E1;
+
+    // Only challenge-0 rounds use E₁, so challenge-1 rounds skip its inversion
+    if (!challenge) {
+        sidh_public_key_from_bytes(&basis1, public_key_alice);
+        get_curve_from_points(&E1, basis1.P, basis1.Q, basis1.P_minus_Q);
+    } else {
+        quadratic_field_set_to_one(&E1);
+    }
+    return sidh_pok_verification_curve(commit, resp, E1, challenge);
+}
+
+static void pok_verification_decode(sidh_pok_precomputation_t *precomputation, const uint8_t commit[COMMITMENT_BYTES]) {
+    sidh_public_key_t *basis3 = &precomputation->basis3;
+
+    quadratic_field_element_from_bytes(&precomputation->A2, commit);
+    sidh_public_key_from_bytes(basis3, &commit[QUADRATIC_FIELD_BYTES]);
+    get_projective_curve_from_points(&precomputation->A3, &precomputation->C3, basis3->P, basis3->Q, basis3->P_minus_Q);
+    precomputation->has_basis2 = 0;
+}
+
+void sidh_pok_verification_precompute(sidh_pok_precomputation_t *precomputation,
+                                      const uint8_t commit[COMMITMENT_BYTES]) {
+    pok_verification_decode(precomputation, commit);
+    canonical_basis_projective(&precomputation->basis2[0],
+                               &precomputation->basis2[1],
+                               &precomputation->basis2[2],
+                               precomputation->A2);
+    precomputation->has_basis2 = 1;
+}
+
+// One challenge-0 branch: the E₂ one derives its basis from the curve (unless precomputed), the E₃ one its affine
+// curve from (A : C). Points stay projective; that affine A of E₃ (the ladder constant) is the only inversion
+typedef struct {
+    const sidh_pok_precomputation_t *precomputation;
+    uint8_t is_E3;
+    const uint64_t *c, *d;
+    quadratic_field_element_t expected; // the codomain of the 3ᵇ walk: E₀ from E₂, E₁ from E₃
+    x_only_point_t basis[3];
+    quadratic_field_element_t A;
+    x_only_point_t K;
+    uint8_t has_kernel;                 // K already computed by the paired ladder
+    uint8_t result;
+} pok_verification_branch_t;
+
+static void pok_verification_branch_setup(pok_verification_branch_t *branch) {
+    const sidh_pok_precomputation_t *precomputation = branch->precomputation;
+    quadratic_field_element_t t;
+
+    if (!branch->is_E3) {
+        quadratic_field_copy(&branch->A, precomputation->A2);
+        if (precomputation->has_basis2) {
+            x_only_point_copy(&branch->basis[0], precomputation->basis2[0]);
+            x_only_point_copy(&branch->basis[1], precomputation->basis2[1]);
+            x_only_point_copy(&branch->basis[2], precomputation->basis2[2]);
+        } else {
+            canonical_basis_projective(&branch->basis[0], &branch->basis[1], &branch->basis[2], branch->A);
+        }
+    } else {
+        quadratic_field_inverse(&t, precomputation->C3);
+        quadratic_field_multiplication(&branch->A, precomputation->A3, t);
+        quadratic_field_copy(&branch->basis[0].X, precomputation->basis3.P);
+        quadratic_field_set_to_one(&branch->basis[0].Z);
+        quadratic_field_copy(&branch->basis[1].X, precomputation->basis3.Q);
+        quadratic_field_set_to_one(&branch->basis[1].Z);
+        quadratic_field_copy(&branch->basis[2].X, precomputation->basis3.P_minus_Q);
+        quadratic_field_set_to_one(&branch->basis[2].Z);
+    }
+}
+
+static void *pok_verification_branch(void *argument) {
+    pok_verification_branch_t *branch = (pok_verification_branch_t *) argument;
+    x_only_point_t T, R;
+    projective_curve_bob_t curve;
+
+    branch->result = EXIT_FAILURE;
+    if (!branch->has_kernel) {
+        pok_verification_branch_setup(branch);
+        if (two_dimensional_normalized_ladder_bob_projective(&branch->K,
+                                                             branch->basis[0],
+                                                             branch->basis[1],
+                                                             branch->basis[2],
+                                                             branch->c,
+                                                             branch->d,
+                                                             branch->A) == EXIT_FAILURE) { return NULL; }
+    }
+    to_projective_curve_bob(&curve, branch->A);
+    x_only_multiple_point_triplings(&T, branch->K, EXPONENT_BOB - 1, curve);
+    x_only_point_tripling(&R, T, curve);
+    if (!x_only_point_is_infinity(R) || x_only_point_is_infinity(T)) { return NULL; }    // full-order?
+
+    x_only_isogeny_from_kernel_curve_bob(&curve, branch->K, curve);
+    if (!projective_curve_is_equal_mixed_bob(curve, branch->expected)) { return NULL; }
+    branch->result = EXIT_SUCCESS;
+    return NULL;
+}
+
+#ifndef PARALLEL_BRANCHES
+// On a single thread, both 2D ladders run in lockstep from one reduction of (c, d)
+static uint8_t pok_verification_branches_pair(pok_verification_branch_t *branch2, pok_verification_branch_t *branch3) {
+    x_only_point_t P[2], Q[2], P_minus_Q[2], K[2];
+    quadratic_field_element_t A[2];
+
+    pok_verification_branch_setup(branch2);
+    pok_verification_branch_setup(branch3);
+    x_only_point_copy(&P[0], branch2->basis[0]);
+    x_only_point_copy(&Q[0], branch2->basis[1]);
+    x_only_point_copy(&P_minus_Q[0], branch2->basis[2]);
+    quadratic_field_copy(&A[0], branch2->A);
+    x_only_point_copy(&P[1], branch3->basis[0]);
+    x_only_point_copy(&Q[1], branch3->basis[1]);
+    x_only_point_copy(&P_minus_Q[1], branch3->basis[2]);
+    quadratic_field_copy(&A[1], branch3->A);
+    if (two_dimensional_normalized_ladder_bob_pair(K, P, Q, P_minus_Q, branch2->c, branch2->d, A) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+    x_only_point_copy(&branch2->K, K[0]);
+    x_only_point_copy(&branch3->K, K[1]);
+    branch2->has_kernel = 1;
+    branch3->has_kernel = 1;
+    return EXIT_SUCCESS;
+}
+#endif
+
+uint8_t sidh_pok_verification_curve(const uint8_t commit[COMMITMENT_BYTES],
+                                    const uint8_t resp[RESPONSE_BYTES],
+                                    quadratic_field_element_t E1,
+                                    uint8_t challenge) {
+    sidh_pok_precomputation_t precomputation;
+
+    // The canonical basis of E₂ is left to the challenge-0 branch, so that it overlaps the E₃ branch
+    pok_verification_decode(&precomputation, commit);
+    return sidh_pok_verification_precomputed(&precomputation, resp, E1, challenge);
+}
+
+// Inversion-free for challenge 1: the basis of E₂ stays projective through φ', and E₃ is compared as (A : C)
+uint8_t sidh_pok_verification_precomputed(const sidh_pok_precomputation_t *precomputation,
+                                          const uint8_t resp[RESPONSE_BYTES],
+                                          quadratic_field_element_t E1,
+                                          uint8_t challenge) {
+    quadratic_field_element_t E0, t;
 
     quadratic_field_set_to_one(&E0);                        // 1
     quadratic_field_addition(&t, E0, E0);   // 2
     quadratic_field_addition(&E0, E0, t);   // 3
     quadratic_field_addition(&E0, E0, E0);  // 6
 
-    sidh_public_key_from_bytes(&basis1, public_key_alice);
-    get_curve_from_points(&E1, basis1.P, basis1.Q, basis1.P_minus_Q);
-
-    quadratic_field_element_from_bytes(&E2, commit);
-    canonical_basis(&basis2, E2);
-
-    sidh_public_key_from_bytes(&basis3, &commit[QUADRATIC_FIELD_BYTES]);
-    get_curve_from_points(&E3, basis3.P, basis3.Q, basis3.P_minus_Q);
     if (!challenge) {
         // challenge = 0
         scalar_t c = {0}, d = {0};
-        x_only_point_t K_psi_dual, K_psi_prime_dual, T, R;
-        projective_curve_bob_t curve2, curve3;
+        pok_verification_branch_t branch2, branch3;
         memcpy((uint8_t *) c, resp, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
         memcpy((uint8_t *) d, &resp[FIELD_BYTES], sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
-        two_dimensional_scalar_multiplication_bob(&K_psi_dual,
-                                                  basis2.P,
-                                                  basis2.Q,
-                                                  basis2.P_minus_Q,
-                                                  c,
-                                                  d,
-                                                  E2);
-        to_projective_curve_bob(&curve2, E2);
-        x_only_multiple_point_triplings(&T, K_psi_dual, EXPONENT_BOB - 1, curve2);
-        x_only_point_tripling(&R, T, curve2);
-        if (!x_only_point_is_infinity(R) || x_only_point_is_infinity(T)) { return EXIT_FAILURE; }    // full-order?
-
-        two_dimensional_scalar_multiplication_bob(&K_psi_prime_dual,
-                                                  basis3.P,
-                                                  basis3.Q,
-                                                  basis3.P_minus_Q,
-                                                  c,
-                                                  d,
-                                                  E3);
-        to_projective_curve_bob(&curve3, E3);
-        x_only_multiple_point_triplings(&T, K_psi_prime_dual, EXPONENT_BOB - 1, curve3);
-        x_only_point_tripling(&R, T, curve3);
-        if (!x_only_point_is_infinity(R) || x_only_point_is_infinity(T)) { return EXIT_FAILURE; }    // full-order?
-
-        x_only_isogeny_from_kernel_curve_bob(&curve2, K_psi_dual, curve2);
-        if (!projective_curve_is_equal_mixed_bob(curve2, E0)) { return EXIT_FAILURE; }
-        x_only_isogeny_from_kernel_curve_bob(&curve3, K_psi_prime_dual, curve3);
-        if (!projective_curve_is_equal_mixed_bob(curve3, E1)) { return EXIT_FAILURE; }
+        branch2 = (pok_verification_branch_t) {.precomputation = precomputation, .c = c, .d = d, .expected = E0};
+        branch3 = (pok_verification_branch_t) {.precomputation = precomputation, .is_E3 = 1, .c = c, .d = d,
+                                               .expected = E1};
+#ifndef PARALLEL_BRANCHES
+        if (pok_verification_branches_pair(&branch2, &branch3) == EXIT_FAILURE) { return EXIT_FAILURE; }
+#endif
+        pok_fork_join(pok_verification_branch, &branch2, pok_verification_branch, &branch3);
+        if (branch2.result != EXIT_SUCCESS || branch3.result != EXIT_SUCCESS) { return EXIT_FAILURE; }
     } else {
         x_only_point_t K_phi_prime, T, R, R_minus_T;
         projective_curve_alice_t curve2;
-        to_projective_curve_alice(&curve2, E2);
+        to_projective_curve_alice(&curve2, precomputation->A2);
         quadratic_field_element_from_bytes(&K_phi_prime.X, resp);
         quadratic_field_set_to_one(&K_phi_prime.Z);
 
@@ -346,22 +589,117 @@ uint8_t sidh_pok_verification(const uint8_t commit[COMMITMENT_BYTES],
         x_only_point_doubling(&R, T, curve2);
         if (!x_only_point_is_infinity(R) || x_only_point_is_infinity(T)) { return EXIT_FAILURE; }    // full-order?
 
-        quadratic_field_copy(&R.X, basis2.P);
-        quadratic_field_set_to_one(&R.Z);
-        quadratic_field_copy(&T.X, basis2.Q);
-        quadratic_field_set_to_one(&T.Z);
-        quadratic_field_copy(&R_minus_T.X, basis2.P_minus_Q);
-        quadratic_field_set_to_one(&R_minus_T.Z);
+        if (precomputation->has_basis2) {
+            x_only_point_copy(&R, precomputation->basis2[0]);
+            x_only_point_copy(&T, precomputation->basis2[1]);
+            x_only_point_copy(&R_minus_T, precomputation->basis2[2]);
+        } else {
+            canonical_basis_projective(&R, &T, &R_minus_T, precomputation->A2);
+        }
         x_only_isogeny_from_kernel_alice(&R,
                                          &T,
                                          &R_minus_T,
                                          &curve2,
                                          K_phi_prime);
-        if (!projective_curve_is_equal_mixed_alice(curve2, E3)) { return EXIT_FAILURE; }
-        if (!x_only_point_is_equal_mixed(R, basis3.P)) { return EXIT_FAILURE; }
-        if (!x_only_point_is_equal_mixed(T, basis3.Q)) { return EXIT_FAILURE; }
-        if (!x_only_point_is_equal_mixed(R_minus_T, basis3.P_minus_Q)) { return EXIT_FAILURE; }
+        if (!projective_curve_is_equal_alice(curve2, precomputation->A3, precomputation->C3)) { return EXIT_FAILURE; }
+        if (!x_only_point_is_equal_mixed(R, precomputation->basis3.P)) { return EXIT_FAILURE; }
+        if (!x_only_point_is_equal_mixed(T, precomputation->basis3.Q)) { return EXIT_FAILURE; }
+        if (!x_only_point_is_equal_mixed(R_minus_T, precomputation->basis3.P_minus_Q)) { return EXIT_FAILURE; }
     }
     return EXIT_SUCCESS;
 }
 
+uint8_t sidh_public_key_compress(uint8_t compressed[COMPRESSED_PUBLIC_KEY_BYTES],
+                                 const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    sidh_public_key_t pk, basis;
+    quadratic_field_element_t A;
+    projective_point_t P_twisted_edwards, Q_twisted_edwards, R1_twisted_edwards, R2_twisted_edwards;
+    twisted_edwards_curve_t curve;
+    scalar_t a0, b0, a1, b1;
+
+    sidh_public_key_from_bytes(&pk, public_key);
+    get_curve_from_points(&A, pk.P, pk.Q, pk.P_minus_Q);
+    if (canonical_basis(&basis, A) == EXIT_FAILURE) { return EXIT_FAILURE; }
+
+    // Both pairs with consistent y-coordinates, thus P - Q = [a₀ - a₁]R₁ + [b₀ - b₁]R₂
+    if (to_twisted_edwards_basis(&R1_twisted_edwards, &R2_twisted_edwards, basis, A) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+    if (to_twisted_edwards_basis(&P_twisted_edwards, &Q_twisted_edwards, pk, A) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+    to_twisted_edwards_curve(&curve, A);
+
+    two_dimensional_pohlig_hellman_bob(a0, b0, P_twisted_edwards, R1_twisted_edwards, R2_twisted_edwards, curve);
+    two_dimensional_pohlig_hellman_bob(a1, b1, Q_twisted_edwards, R1_twisted_edwards, R2_twisted_edwards, curve);
+
+    quadratic_field_element_to_bytes(compressed, A);
+    memcpy(&compressed[QUADRATIC_FIELD_BYTES], (const uint8_t *) a0, SECRET_KEY_BYTES_BOB);
+    memcpy(&compressed[QUADRATIC_FIELD_BYTES + SECRET_KEY_BYTES_BOB], (const uint8_t *) b0, SECRET_KEY_BYTES_BOB);
+    memcpy(&compressed[QUADRATIC_FIELD_BYTES + 2 * SECRET_KEY_BYTES_BOB], (const uint8_t *) a1, SECRET_KEY_BYTES_BOB);
+    memcpy(&compressed[QUADRATIC_FIELD_BYTES + 3 * SECRET_KEY_BYTES_BOB], (const uint8_t *) b1, SECRET_KEY_BYTES_BOB);
+    return EXIT_SUCCESS;
+}
+
+// output = input_a - input_b mod 3ᵇ, with input_a and input_b in [0, 3ᵇ)
+static void scalar_subtraction_bob(scalar_t output, const scalar_t input_a, const scalar_t input_b) {
+    scalar_t order;
+    if (multiprecision_is_smaller(input_a, input_b, SUBGROUP_ORDER_64BITS_WORDS)) {
+        scalar_power_of_three(order, EXPONENT_BOB);
+        multiprecision_addition(output, input_a, order, SUBGROUP_ORDER_64BITS_WORDS);
+        multiprecision_subtraction(output, output, input_b, SUBGROUP_ORDER_64BITS_WORDS);
+    } else {
+        multiprecision_subtraction(output, input_a, input_b, SUBGROUP_ORDER_64BITS_WORDS);
+    }
+}
+
+uint8_t sidh_public_key_decompress(uint8_t public_key[PUBLIC_KEY_BYTES],
+                                   const uint8_t compressed[COMPRESSED_PUBLIC_KEY_BYTES]) {
+    sidh_public_key_t pk, basis;
+    quadratic_field_element_t A;
+    x_only_point_t P, Q, P_minus_Q;
+    scalar_t a0 = {0}, b0 = {0}, a1 = {0}, b1 = {0}, c, d, zero = {0};
+
+    quadratic_field_element_from_bytes(&A, compressed);
+    memcpy((uint8_t *) a0, &compressed[QUADRATIC_FIELD_BYTES], SECRET_KEY_BYTES_BOB);
+    memcpy((uint8_t *) b0, &compressed[QUADRATIC_FIELD_BYTES + SECRET_KEY_BYTES_BOB], SECRET_KEY_BYTES_BOB);
+    memcpy((uint8_t *) a1, &compressed[QUADRATIC_FIELD_BYTES + 2 * SECRET_KEY_BYTES_BOB], SECRET_KEY_BYTES_BOB);
+    memcpy((uint8_t *) b1, &compressed[QUADRATIC_FIELD_BYTES + 3 * SECRET_KEY_BYTES_BOB], SECRET_KEY_BYTES_BOB);
+
+    // Scalars must be reduced modulo 3ᵇ, and no pair can be zero (the ladder would never end)
+    scalar_power_of_three(c, EXPONENT_BOB);
+    if (!multiprecision_is_smaller(a0, c, SUBGROUP_ORDER_64BITS_WORDS) ||
+        !multiprecision_is_smaller(b0, c, SUBGROUP_ORDER_64BITS_WORDS) ||
+        !multiprecision_is_smaller(a1, c, SUBGROUP_ORDER_64BITS_WORDS) ||
+        !multiprecision_is_smaller(b1, c, SUBGROUP_ORDER_64BITS_WORDS)) { return EXIT_FAILURE; }
+    if ((memcmp(a0, zero, sizeof(scalar_t)) == 0 && memcmp(b0, zero, sizeof(scalar_t)) == 0) ||
+        (memcmp(a1, zero, sizeof(scalar_t)) == 0 && memcmp(b1, zero, sizeof(scalar_t)) == 0) ||
+        (memcmp(a0, a1, sizeof(scalar_t)) == 0 && memcmp(b0, b1, sizeof(scalar_t)) == 0)) { return EXIT_FAILURE; }
+
+    if (canonical_basis(&basis, A) == EXIT_FAILURE) { return EXIT_FAILURE; }
+
+    two_dimensional_scalar_multiplication_bob(&P, basis.P, basis.Q, basis.P_minus_Q, a0, b0, A);
+    two_dimensional_scalar_multiplication_bob(&Q, basis.P, basis.Q, basis.P_minus_Q, a1, b1, A);
+    scalar_subtraction_bob(c, a0, a1);
+    scalar_subtraction_bob(d, b0, b1);
+    two_dimensional_scalar_multiplication_bob(&P_minus_Q, basis.P, basis.Q, basis.P_minus_Q, c, d, A);
+
+    simultaneous_three_inverses(&P.Z, &Q.Z, &P_minus_Q.Z);
+    quadratic_field_multiplication(&pk.P, P.X, P.Z);
+    quadratic_field_multiplication(&pk.Q, Q.X, Q.Z);
+    quadratic_field_multiplication(&pk.P_minus_Q, P_minus_Q.X, P_minus_Q.Z);
+    sidh_public_key_to_bytes(public_key, &pk);
+    return EXIT_SUCCESS;
+}
+
+uint8_t sidh_pok_commitment_compress(uint8_t compressed[COMPRESSED_COMMITMENT_BYTES],
+                                     const uint8_t commit[COMMITMENT_BYTES]) {
+    memcpy(compressed, commit, QUADRATIC_FIELD_BYTES);
+    return sidh_public_key_compress(&compressed[QUADRATIC_FIELD_BYTES], &commit[QUADRATIC_FIELD_BYTES]);
+}
+
+uint8_t sidh_pok_commitment_decompress(uint8_t commit[COMMITMENT_BYTES],
+                                       const uint8_t compressed[COMPRESSED_COMMITMENT_BYTES]) {
+    memcpy(commit, compressed, QUADRATIC_FIELD_BYTES);
+    return sidh_public_key_decompress(&commit[QUADRATIC_FIELD_BYTES], &compressed[QUADRATIC_FIELD_BYTES]);
+}
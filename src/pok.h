@@ -13,10 +13,36 @@
 #define INSIGHT_BYTES       (2*QUADRATIC_FIELD_BYTES + COMMITMENT_BYTES) // {ker φ', ker (dual of ψ), E₂, P₂, Q₂, P₂-Q₂}
 #define RESPONSE_BYTES      QUADRATIC_FIELD_BYTES    // either ker φ' or decomposition by scalars (c, d) of the dual of ψ
 
+#define COMPRESSED_PUBLIC_KEY_BYTES (QUADRATIC_FIELD_BYTES + 4*SECRET_KEY_BYTES_BOB)        // {A, a₀, b₀, a₁, b₁}
+#define COMPRESSED_COMMITMENT_BYTES (QUADRATIC_FIELD_BYTES + COMPRESSED_PUBLIC_KEY_BYTES)   // {E₂, compressed {P₃, Q₃, P₃-Q₃}}
+
+// In-process insight kept in Montgomery representation between commitment and response
+typedef struct {
+    quadratic_field_element_t K_phi;        // ker φ'
+    quadratic_field_element_t K_psi_dual;   // ker (dual of ψ)
+    quadratic_field_element_t A;            // E₂
+    sidh_public_key_t basis;                // {P₂, Q₂, P₂-Q₂}
+} sidh_pok_insight_t;
+
+// Challenge-independent part of a round verification, computed from the commitment alone
+typedef struct {
+    quadratic_field_element_t A2;           // E₂
+    x_only_point_t basis2[3];               // canonical basis of E₂ (projective), when has_basis2 is set
+    sidh_public_key_t basis3;               // {P₃, Q₃, P₃-Q₃}
+    quadratic_field_element_t A3, C3;       // E₃ as (A : C)
+    uint8_t has_basis2;
+} sidh_pok_precomputation_t;
+
 // *************** INTERNAL FUNCTIONS *******************//
 
 void random_private_key_sample(uint8_t output[SECRET_KEY_BYTES_BOB + 1], keccak_state *state);
 
+// The canonical basis of E[3ᵇ] as returned by the Elligator 2 search, before normalization
+uint8_t canonical_basis_projective(x_only_point_t *output_P,
+                                   x_only_point_t *output_Q,
+                                   x_only_point_t *output_P_minus_Q,
+                                   quadratic_field_element_t input_A);
+
 uint8_t canonical_basis(sidh_public_key_t *output_basis, quadratic_field_element_t input_A);
 
 // Next function should use to decompose the kernel of the dual isogeny
@@ -24,25 +50,80 @@ uint8_t decomposition_by_scalars(scalar_t output_c,
                                  scalar_t output_d,
                                  quadratic_field_element_t input_kernel,
                                  sidh_public_key_t input_basis,
-                                 quadratic_field_element_t input_A);
+                                 quadratic_field_element_t input_A,
+                                 projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]);
 
 
 // ****************** EXTERNAL API *******************//
 
 
-// The knowledge is Alice's private key
+// The knowledge is Alice's private key. On failure (no canonical basis on the commitment curve), commit and insight
+// are zeroed
 uint8_t sidh_pok_commitment(uint8_t commit[384], uint8_t insight[576], const uint8_t private_key_alice[24],
                          keccak_state *state);
 
+// Same as above, but the insight stays in memory (no serialization); bytes are only needed to persist it
+uint8_t sidh_pok_commitment_insight(uint8_t commit[COMMITMENT_BYTES],
+                                    sidh_pok_insight_t *insight,
+                                    const uint8_t private_key_alice[SECRET_KEY_BYTES_ALICE],
+                                    keccak_state *state);
+
+void sidh_pok_insight_to_bytes(uint8_t insight_bytes[INSIGHT_BYTES], const sidh_pok_insight_t *insight);
+
+void sidh_pok_insight_from_bytes(sidh_pok_insight_t *insight, const uint8_t insight_bytes[INSIGHT_BYTES]);
+
 void sidh_pok_challenge(uint8_t *challenge, const uint8_t *commitment, uint64_t commitment_size,
                         const uint8_t *statement, uint64_t statement_size);
 
 uint8_t sidh_pok_response(uint8_t resp[RESPONSE_BYTES], const uint8_t insight[INSIGHT_BYTES], uint8_t challenge);
 
+// Same as above, with the Pohlig-Hellman multiples in a caller-supplied workspace
+uint8_t sidh_pok_response_workspace(uint8_t resp[RESPONSE_BYTES],
+                                    const uint8_t insight[INSIGHT_BYTES],
+                                    uint8_t challenge,
+                                    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]);
+
+uint8_t sidh_pok_response_insight(uint8_t resp[RESPONSE_BYTES],
+                                  const sidh_pok_insight_t *insight,
+                                  uint8_t challenge,
+                                  projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]);
+
 uint8_t sidh_pok_verification(const uint8_t commit[COMMITMENT_BYTES],
                               const uint8_t resp[RESPONSE_BYTES],
                               const uint8_t public_key_alice[PUBLIC_KEY_BYTES],
                               uint8_t challenge);
 
+// Same as sidh_pok_verification, with the public key given by its curve coefficient E₁ (Montgomery form)
+uint8_t sidh_pok_verification_curve(const uint8_t commit[COMMITMENT_BYTES],
+                                    const uint8_t resp[RESPONSE_BYTES],
+                                    quadratic_field_element_t E1,
+                                    uint8_t challenge);
+
+// Decodes E₂ and E₃ and finds the canonical basis of E₂, before the challenge is known
+void sidh_pok_verification_precompute(sidh_pok_precomputation_t *precomputation,
+                                      const uint8_t commit[COMMITMENT_BYTES]);
+
+// Same as sidh_pok_verification_curve, on a commitment already run through sidh_pok_verification_precompute
+uint8_t sidh_pok_verification_precomputed(const sidh_pok_precomputation_t *precomputation,
+                                          const uint8_t resp[RESPONSE_BYTES],
+                                          quadratic_field_element_t E1,
+                                          uint8_t challenge);
+
+// Challenge-1 rounds only: given E₂ in commit[0..QUADRATIC_FIELD_BYTES), it recomputes {P₃, Q₃, P₃-Q₃} from ker φ'
+uint8_t sidh_pok_commitment_recovery(uint8_t commit[COMMITMENT_BYTES], const uint8_t resp[RESPONSE_BYTES]);
+
+// {P, Q, P-Q} as scalars modulo 3ᵇ with respect to the canonical basis {R₁, R₂}: P = [a₀]R₁ + [b₀]R₂, Q = [a₁]R₁ + [b₁]R₂
+uint8_t sidh_public_key_compress(uint8_t compressed[COMPRESSED_PUBLIC_KEY_BYTES],
+                                 const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+uint8_t sidh_public_key_decompress(uint8_t public_key[PUBLIC_KEY_BYTES],
+                                   const uint8_t compressed[COMPRESSED_PUBLIC_KEY_BYTES]);
+
+uint8_t sidh_pok_commitment_compress(uint8_t compressed[COMPRESSED_COMMITMENT_BYTES],
+                                     const uint8_t commit[COMMITMENT_BYTES]);
+
+uint8_t sidh_pok_commitment_decompress(uint8_t commit[COMMITMENT_BYTES],
+                                       const uint8_t compressed[COMPRESSED_COMMITMENT_BYTES]);
+
 #endif //SIDH_POK_POK_H
 
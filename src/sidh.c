@@ -42,6 +42,29 @@ void get_curve_from_points(quadratic_field_element_t *output,
     quadratic_field_subtraction(output, *output, t1);
 }
 
+// (A : C) with C = 4×xP×xQ×x(P-Q), without the inversion of get_curve_from_points
+void get_projective_curve_from_points(quadratic_field_element_t *output_A,
+                                      quadratic_field_element_t *output_C,
+                                      quadratic_field_element_t input_P,
+                                      quadratic_field_element_t input_Q,
+                                      quadratic_field_element_t input_P_minus_Q) {
+    quadratic_field_element_t t0, t1, one;
+    quadratic_field_set_to_one(&one);
+
+    quadratic_field_addition(&t1, input_P, input_Q);
+    quadratic_field_multiplication(&t0, input_P, input_Q);
+    quadratic_field_multiplication(output_A, input_P_minus_Q, t1);
+    quadratic_field_addition(output_A, t0, *output_A);
+    quadratic_field_multiplication(&t0, t0, input_P_minus_Q);
+    quadratic_field_subtraction(output_A, *output_A, one);
+    quadratic_field_addition(&t0, t0, t0);
+    quadratic_field_addition(&t1, t1, input_P_minus_Q);
+    quadratic_field_addition(output_C, t0, t0);
+    quadratic_field_square(output_A, *output_A);
+    quadratic_field_multiplication(&t1, t1, *output_C);
+    quadratic_field_subtraction(output_A, *output_A, t1);
+}
+
 // +++++++ ALICE
 void sidh_generate_private_key_alice(sidh_private_key_t *private_key_alice, keccak_state *state) {
     shake256_squeeze((uint8_t *) private_key_alice, SECRET_KEY_BYTES_ALICE, state);
@@ -88,6 +111,48 @@ void sidh_get_public_key_from_private_key_alice(sidh_public_key_t *public_key_al
     quadratic_field_multiplication(&public_key_alice->P_minus_Q, P_minus_Q.X, P_minus_Q.Z);
 }
 
+void sidh_fixed_base_table_alice(x_only_fixed_base_t table[EXPONENT_ALICE]) {
+    quadratic_field_element_t a, t, xP, xQ, xP_minus_Q;
+    quadratic_field_set_to_one(&a);                     // 1
+    quadratic_field_addition(&t, a, a); // 2
+    quadratic_field_addition(&a, t, a); // 3
+    quadratic_field_addition(&a, a, a); // 6
+
+    initialize_basis(&xP, &xQ, &xP_minus_Q, PUBLIC_POINT_GENERATORS_ALICE);
+    x_only_fixed_base_table(table, xQ, SUBGROUP_ORDER_BITS_ALICE, a);
+}
+
+void sidh_get_projective_public_key_alice(x_only_point_t output_points[3],
+                                          const sidh_private_key_t *private_key_alice,
+                                          const x_only_fixed_base_t table[EXPONENT_ALICE]) {
+    quadratic_field_element_t a, t, xP, xQ, xP_minus_Q;
+    quadratic_field_set_to_one(&a);                     // 1
+    quadratic_field_addition(&t, a, a); // 2
+    quadratic_field_addition(&a, t, a); // 3
+    quadratic_field_addition(&a, a, a); // 6
+
+    projective_curve_alice_t curve;
+    to_projective_curve_alice(&curve, a);
+
+    // +++++++ order-2ᵃ point generators (secret kernel point computation)
+    x_only_point_t K = {0};
+    initialize_basis(&xP, &xQ, &xP_minus_Q, PUBLIC_POINT_GENERATORS_ALICE);
+    x_only_three_point_ladder_fixed_base(&K,
+                                         xP,
+                                         xP_minus_Q,
+                                         table,
+                                         private_key_alice->key,
+                                         SUBGROUP_ORDER_BITS_ALICE);
+
+    // +++++++ order-3ᵇ point generators (public key)
+    initialize_basis(&output_points[0].X, &output_points[1].X, &output_points[2].X, PUBLIC_POINT_GENERATORS_BOB);
+    quadratic_field_set_to_one(&output_points[0].Z);
+    quadratic_field_set_to_one(&output_points[1].Z);
+    quadratic_field_set_to_one(&output_points[2].Z);
+
+    x_only_isogeny_from_kernel_alice(&output_points[0], &output_points[1], &output_points[2], &curve, K);
+}
+
 void sidh_key_agreement_alice(sidh_shared_secret_t *shared_secret_alice,
                               const sidh_private_key_t *private_key_alice,
                               const sidh_public_key_t *public_key_bob) {
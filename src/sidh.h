@@ -33,11 +33,25 @@ void get_curve_from_points(quadratic_field_element_t *output,
                            quadratic_field_element_t input_Q,
                            quadratic_field_element_t input_P_minus_Q);
 
+void get_projective_curve_from_points(quadratic_field_element_t *output_A,
+                                      quadratic_field_element_t *output_C,
+                                      quadratic_field_element_t input_P,
+                                      quadratic_field_element_t input_Q,
+                                      quadratic_field_element_t input_P_minus_Q);
+
 void sidh_generate_private_key_alice(sidh_private_key_t *private_key_alice, keccak_state *state);
 
 void sidh_get_public_key_from_private_key_alice(sidh_public_key_t *public_key_alice,
                                                 const sidh_private_key_t *private_key_alice);
 
+// Fixed-base table of the order-2ᵃ generator Q, shared by every key derived from the same generators
+void sidh_fixed_base_table_alice(x_only_fixed_base_t table[EXPONENT_ALICE]);
+
+// Public key points P, Q, P - Q left projective, so that a batch of keys can share one inversion
+void sidh_get_projective_public_key_alice(x_only_point_t output_points[3],
+                                          const sidh_private_key_t *private_key_alice,
+                                          const x_only_fixed_base_t table[EXPONENT_ALICE]);
+
 void sidh_key_agreement_alice(sidh_shared_secret_t *shared_secret_alice,
                               const sidh_private_key_t *private_key_alice,
                               const sidh_public_key_t *public_key_bob);
@@ -4,8 +4,13 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "signature.h"
 #include "sidh.h"
+#include "utilities.h"
+#include "digest.h"
 
 uint8_t sidh_signature_key_generation(uint8_t private_key_bytes[SECRET_KEY_BYTES],
                                       uint8_t public_key_bytes[PUBLIC_KEY_BYTES],
@@ -21,44 +26,203 @@ uint8_t sidh_signature_key_generation(uint8_t private_key_bytes[SECRET_KEY_BYTES
     return EXIT_SUCCESS;
 }
 
-uint8_t sidh_signature_sign(uint8_t signature[SIGNATURE_BYTES],
-                            const uint8_t *message,
-                            uint64_t message_length,
-                            const uint8_t private_key[SECRET_KEY_BYTES],
-                            const uint8_t public_key[PUBLIC_KEY_BYTES],
-                            keccak_state *state) {
-    if (message_length == 0) {
-        return EXIT_FAILURE;
+typedef struct {
+    const sidh_private_key_t *private_keys;
+    x_only_point_t *points;                 // three per key
+    const x_only_fixed_base_t *table;
+    uint64_t first_key;
+    uint64_t last_key;
+} key_generation_share_t;
+
+static void *key_generation_thread(void *argument) {
+    key_generation_share_t *share = (key_generation_share_t *) argument;
+
+    for (uint64_t i = share->first_key; i < share->last_key; i++) {
+        sidh_get_projective_public_key_alice(&share->points[3 * i], &share->private_keys[i], share->table);
+    }
+    return NULL;
+}
+
+uint8_t sidh_signature_key_generation_batch(uint8_t *private_keys_bytes,
+                                            uint8_t *public_keys_bytes,
+                                            uint64_t number_of_keys,
+                                            keccak_state *state,
+                                            unsigned int number_of_threads) {
+    sidh_private_key_t *private_keys;
+    x_only_fixed_base_t *table;
+    x_only_point_t *points;
+    key_generation_share_t *shares;
+    pthread_t *threads;
+    sidh_public_key_t public_key;
+    unsigned int i, started;
+    uint64_t k;
+    uint8_t returned_value = EXIT_FAILURE;
+
+    if (number_of_keys == 0) { return EXIT_SUCCESS; }
+    if (number_of_threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        number_of_threads = (cores > 0) ? (unsigned int) cores : 1;
+    }
+    if (number_of_threads > number_of_keys) { number_of_threads = (unsigned int) number_of_keys; }
+
+    private_keys = malloc(number_of_keys * sizeof(sidh_private_key_t));
+    points = malloc(3 * number_of_keys * sizeof(x_only_point_t));
+    table = malloc(EXPONENT_ALICE * sizeof(x_only_fixed_base_t));
+    shares = malloc(number_of_threads * sizeof(key_generation_share_t));
+    threads = malloc(number_of_threads * sizeof(pthread_t));
+    if (private_keys == NULL || points == NULL || table == NULL || shares == NULL || threads == NULL) { goto end; }
+
+    // Same keys, in the same order, as number_of_keys calls to sidh_signature_key_generation
+    for (k = 0; k < number_of_keys; k++) {
+        sidh_generate_private_key_alice(&private_keys[k], state);
+    }
+    sidh_fixed_base_table_alice(table);
+
+    for (i = 0; i < number_of_threads; i++) {
+        shares[i].private_keys = private_keys;
+        shares[i].points = points;
+        shares[i].table = table;
+        shares[i].first_key = (number_of_keys * i) / number_of_threads;
+        shares[i].last_key = (number_of_keys * (i + 1)) / number_of_threads;
+    }
+
+    // The calling thread takes the first share; a thread that fails to start has its share run here too
+    for (started = 1; started < number_of_threads; started++) {
+        if (pthread_create(&threads[started], NULL, key_generation_thread, &shares[started]) != 0) { break; }
+    }
+    key_generation_thread(&shares[0]);
+    for (i = started; i < number_of_threads; i++) { key_generation_thread(&shares[i]); }
+    for (i = 1; i < started; i++) { pthread_join(threads[i], NULL); }
+
+    // One inversion for the whole batch
+    x_only_points_to_affine(points, 3 * number_of_keys);
+    for (k = 0; k < number_of_keys; k++) {
+        quadratic_field_copy(&public_key.P, points[3 * k].X);
+        quadratic_field_copy(&public_key.Q, points[3 * k + 1].X);
+        quadratic_field_copy(&public_key.P_minus_Q, points[3 * k + 2].X);
+        sidh_public_key_to_bytes(&public_keys_bytes[PUBLIC_KEY_BYTES * k], &public_key);
+        sidh_private_key_to_bytes_alice(&private_keys_bytes[SECRET_KEY_BYTES * k], &private_keys[k]);
     }
+    returned_value = EXIT_SUCCESS;
+
+    end:
+    if (private_keys != NULL) { memset(private_keys, 0, number_of_keys * sizeof(sidh_private_key_t)); }
+    free(threads);
+    free(shares);
+    free(table);
+    free(points);
+    free(private_keys);
+    return returned_value;
+}
+
+// Fiat-Shamir challenge: SHAKE256(commitments || 0xFF || digest || public key)
+void sidh_signature_challenge_digest(uint8_t challenge_bytes[SECURITY_BITS / 8],
+                                     const uint8_t commitments[COMMITMENT_BYTES * SECURITY_BITS],
+                                     const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                     const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint8_t statement[PUBLIC_KEY_BYTES + MESSAGE_DIGEST_BYTES] = {0};
+
+    memcpy(statement, digest, MESSAGE_DIGEST_BYTES);
+    memcpy(&statement[MESSAGE_DIGEST_BYTES], public_key, PUBLIC_KEY_BYTES);
+    sidh_pok_challenge(challenge_bytes, commitments, COMMITMENT_BYTES * SECURITY_BITS, statement, sizeof(statement));
+}
+
+void sidh_signature_challenge(uint8_t challenge_bytes[SECURITY_BITS / 8],
+                              const uint8_t commitments[COMMITMENT_BYTES * SECURITY_BITS],
+                              const uint8_t *message,
+                              uint64_t message_length,
+                              const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+
+    sidh_message_digest(digest, message, message_length);
+    sidh_signature_challenge_digest(challenge_bytes, commitments, digest, public_key);
+}
+
+static uint8_t signature_sign(uint8_t signature[SIGNATURE_BYTES],
+                              uint8_t challenge_bytes[SECURITY_BITS / 8],
+                              const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                              const uint8_t private_key[SECRET_KEY_BYTES],
+                              const uint8_t public_key[PUBLIC_KEY_BYTES],
+                              keccak_state *state,
+                              sidh_pok_insight_t insights[SECURITY_BITS],
+                              projective_point_t pohlig_hellman[POHLIG_HELLMAN_WORKSPACE_POINTS]) {
     uint8_t returned_value = EXIT_SUCCESS;
-    uint8_t insights[INSIGHT_BYTES * SECURITY_BITS] = {0};
-    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
-    uint8_t statement[PUBLIC_KEY_BYTES + (SECURITY_BITS / 8)] = {0};
 
     for (uint8_t i = 0; i < SECURITY_BITS / 8; i++) {
         for (uint8_t j = 0; j < 8; j++) {
-            returned_value |= sidh_pok_commitment(&signature[COMMITMENT_BYTES * ((i * 8) + j)],
-                                                  &insights[INSIGHT_BYTES * ((i * 8) + j)],
-                                                  private_key, state);
+            returned_value |= sidh_pok_commitment_insight(&signature[COMMITMENT_BYTES * ((i * 8) + j)],
+                                                          &insights[(i * 8) + j],
+                                                          private_key, state);
         }
     }
 
-    shake256(statement, SECURITY_BITS / 8, message, message_length);
-    memcpy(&statement[SECURITY_BITS / 8], public_key, PUBLIC_KEY_BYTES);
-    sidh_pok_challenge(challenge_bytes, signature, COMMITMENT_BYTES * SECURITY_BITS, statement, sizeof(statement));
+    sidh_signature_challenge_digest(challenge_bytes, signature, digest, public_key);
 
     for (uint8_t i = 0; i < SECURITY_BITS / 8; i++) {
         for (uint8_t j = 0; j < 8; j++) {
-            returned_value |= sidh_pok_response(
+            returned_value |= sidh_pok_response_insight(
                 &signature[(COMMITMENT_BYTES * SECURITY_BITS) + (RESPONSE_BYTES * ((i * 8) + j))],
-                &insights[INSIGHT_BYTES * ((i * 8) + j)],
-                (challenge_bytes[i] >> j) & 1);
+                &insights[(i * 8) + j],
+                (challenge_bytes[i] >> j) & 1,
+                pohlig_hellman);
         }
     }
 
     return returned_value;
 }
 
+// Challenge-1 rounds keep E₂ only since {P₃, Q₃, P₃-Q₃} can be recomputed from the response (that is, ker φ')
+static void signature_compress(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                               uint64_t *compact_signature_length,
+                               const uint8_t signature[SIGNATURE_BYTES],
+                               const uint8_t challenge_bytes[SECURITY_BITS / 8]) {
+    uint64_t position = SECURITY_BITS / 8;
+
+    memcpy(compact_signature, challenge_bytes, SECURITY_BITS / 8);
+    for (uint8_t i = 0; i < SECURITY_BITS / 8; i++) {
+        for (uint8_t j = 0; j < 8; j++) {
+            const uint8_t *commit = &signature[COMMITMENT_BYTES * ((i * 8) + j)];
+            if ((challenge_bytes[i] >> j) & 1) {
+                memcpy(&compact_signature[position], commit, QUADRATIC_FIELD_BYTES);
+                position += QUADRATIC_FIELD_BYTES;
+            } else {
+                memcpy(&compact_signature[position], commit, COMMITMENT_BYTES);
+                position += COMMITMENT_BYTES;
+            }
+        }
+    }
+    memcpy(&compact_signature[position],
+           &signature[COMMITMENT_BYTES * SECURITY_BITS],
+           RESPONSE_BYTES * SECURITY_BITS);
+    *compact_signature_length = position + (RESPONSE_BYTES * SECURITY_BITS);
+}
+
+uint8_t sidh_signature_sign(uint8_t signature[SIGNATURE_BYTES],
+                            const uint8_t *message,
+                            uint64_t message_length,
+                            const uint8_t private_key[SECRET_KEY_BYTES],
+                            const uint8_t public_key[PUBLIC_KEY_BYTES],
+                            keccak_state *state) {
+    if (message_length == 0) {
+        return EXIT_FAILURE;
+    }
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+
+    sidh_message_digest(digest, message, message_length);
+    return sidh_signature_sign_digest(signature, digest, private_key, public_key, state);
+}
+
+uint8_t sidh_signature_sign_digest(uint8_t signature[SIGNATURE_BYTES],
+                                   const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                   const uint8_t private_key[SECRET_KEY_BYTES],
+                                   const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                   keccak_state *state) {
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+    sidh_pok_insight_t insights[SECURITY_BITS];
+    projective_point_t pohlig_hellman[POHLIG_HELLMAN_WORKSPACE_POINTS];
+    return signature_sign(signature, challenge_bytes, digest, private_key, public_key, state, insights, pohlig_hellman);
+}
+
 uint8_t sidh_signature_verify(const uint8_t signature[SIGNATURE_BYTES],
                               const uint8_t *message,
                               uint64_t message_length,
@@ -66,25 +230,314 @@ uint8_t sidh_signature_verify(const uint8_t signature[SIGNATURE_BYTES],
     if (message_length == 0) {
         return EXIT_FAILURE;
     }
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+
+    sidh_message_digest(digest, message, message_length);
+    return sidh_signature_verify_digest(signature, digest, public_key);
+}
+
+uint8_t sidh_signature_prepare_public_key(sidh_prepared_public_key_t *prepared,
+                                         const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    sidh_public_key_t pk;
+    quadratic_field_element_t t, four;
+
+    memset(prepared, 0, sizeof(sidh_prepared_public_key_t));
+    memcpy(prepared->public_key, public_key, PUBLIC_KEY_BYTES);
+    sidh_public_key_from_bytes(&pk, public_key);
+    get_curve_from_points(&prepared->A, pk.P, pk.Q, pk.P_minus_Q);
+
+    // Non-zero x-coordinates on a non-singular curve (A² ≠ 4)
+    quadratic_field_set_to_one(&four);
+    quadratic_field_addition(&four, four, four);
+    quadratic_field_addition(&four, four, four);
+    quadratic_field_square(&t, prepared->A);
+    quadratic_field_subtraction(&t, t, four);
+    prepared->valid = !quadratic_field_is_zero(pk.P) && !quadratic_field_is_zero(pk.Q) &&
+                      !quadratic_field_is_zero(pk.P_minus_Q) && !quadratic_field_is_zero(t);
+    return prepared->valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// All rounds in order, or when failing fast: challenge-1 rounds (a single 2ᵃ walk) before challenge-0 rounds
+// (2D scalar multiplications and two 3ᵇ walks), stopping at the first failed round
+static uint8_t signature_verify_rounds(const uint8_t signature[SIGNATURE_BYTES],
+                                       const uint8_t challenge_bytes[SECURITY_BITS / 8],
+                                       const sidh_prepared_public_key_t *public_key,
+                                       uint8_t fail_fast) {
+    uint8_t returned_value = 0, challenge;
+
+    for (int8_t pass = 1; pass >= 0; pass--) {
+        for (uint16_t round = 0; round < SECURITY_BITS; round++) {
+            challenge = (challenge_bytes[round / 8] >> (round % 8)) & 1;
+            if (fail_fast && challenge != pass) { continue; }
+            returned_value |= sidh_pok_verification_curve(
+                    &signature[COMMITMENT_BYTES * round],
+                    &signature[(COMMITMENT_BYTES * SECURITY_BITS) + (RESPONSE_BYTES * round)],
+                    public_key->A,
+                    challenge);
+            if (fail_fast && returned_value != EXIT_SUCCESS) { return EXIT_FAILURE; }
+        }
+        if (!fail_fast) { break; }
+    }
+    return returned_value;
+}
+
+uint8_t sidh_signature_verify_digest(const uint8_t signature[SIGNATURE_BYTES],
+                                     const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                     const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+    sidh_prepared_public_key_t prepared;
+
+    // The public key is decoded once rather than per round
+    sidh_signature_prepare_public_key(&prepared, public_key);
+    sidh_signature_challenge_digest(challenge_bytes, signature, digest, public_key);
+    return signature_verify_rounds(signature, challenge_bytes, &prepared, 0);
+}
+
+// Verification handles public data only, so the early exit leaks nothing
+uint8_t sidh_signature_verify_fail_fast(const uint8_t signature[SIGNATURE_BYTES],
+                                        const uint8_t *message,
+                                        uint64_t message_length,
+                                        const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    sidh_prepared_public_key_t prepared;
+
+    sidh_signature_prepare_public_key(&prepared, public_key);
+    prepared.valid = 1;
+    return sidh_signature_verify_prepared(signature, message, message_length, &prepared);
+}
+
+uint8_t sidh_signature_verify_prepared(const uint8_t signature[SIGNATURE_BYTES],
+                                       const uint8_t *message,
+                                       uint64_t message_length,
+                                       const sidh_prepared_public_key_t *public_key) {
+    if (message_length == 0 || !public_key->valid) {
+        return EXIT_FAILURE;
+    }
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+
+    sidh_signature_challenge(challenge_bytes, signature, message, message_length, public_key->public_key);
+    return signature_verify_rounds(signature, challenge_bytes, public_key, 1);
+}
+
+uint8_t sidh_signature_verifier_init(sidh_signature_verifier_t *verifier,
+                                     const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                     const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    verifier->received = 0;
+    verifier->precomputed = 0;
+    memcpy(verifier->digest, digest, MESSAGE_DIGEST_BYTES);
+    verifier->failed = (uint8_t) (sidh_signature_prepare_public_key(&verifier->public_key, public_key) != EXIT_SUCCESS);
+    return verifier->failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+uint8_t sidh_signature_verifier_update(sidh_signature_verifier_t *verifier, const uint8_t *chunk, uint64_t chunk_length) {
+    if (verifier->failed || chunk_length > SIGNATURE_BYTES - verifier->received) {
+        verifier->failed = 1;
+        return EXIT_FAILURE;
+    }
+    memcpy(&verifier->signature[verifier->received], chunk, chunk_length);
+    verifier->received += chunk_length;
+
+    // Commitments come first: every one completed by this chunk is precomputed now
+    while (verifier->precomputed < SECURITY_BITS &&
+           verifier->received >= (uint64_t) COMMITMENT_BYTES * (verifier->precomputed + 1)) {
+        sidh_pok_verification_precompute(&verifier->rounds[verifier->precomputed],
+                                         &verifier->signature[COMMITMENT_BYTES * verifier->precomputed]);
+        verifier->precomputed++;
+    }
+    return EXIT_SUCCESS;
+}
+
+uint8_t sidh_signature_verifier_final(sidh_signature_verifier_t *verifier) {
+    uint8_t returned_value = 0, challenge;
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+
+    if (verifier->failed || verifier->received != SIGNATURE_BYTES) { return EXIT_FAILURE; }
+
+    sidh_signature_challenge_digest(challenge_bytes, verifier->signature, verifier->digest,
+                                    verifier->public_key.public_key);
+    for (uint16_t round = 0; round < SECURITY_BITS; round++) {
+        challenge = (challenge_bytes[round / 8] >> (round % 8)) & 1;
+        returned_value |= sidh_pok_verification_precomputed(
+                &verifier->rounds[round],
+                &verifier->signature[(COMMITMENT_BYTES * SECURITY_BITS) + (RESPONSE_BYTES * round)],
+                verifier->public_key.A,
+                challenge);
+    }
+    return returned_value;
+}
+
+uint8_t sidh_signature_sign_compact(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                                    uint64_t *compact_signature_length,
+                                    const uint8_t *message,
+                                    uint64_t message_length,
+                                    const uint8_t private_key[SECRET_KEY_BYTES],
+                                    const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                    keccak_state *state) {
+    if (message_length == 0) {
+        return EXIT_FAILURE;
+    }
+    uint8_t returned_value;
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+    sidh_pok_insight_t insights[SECURITY_BITS];
+    projective_point_t pohlig_hellman[POHLIG_HELLMAN_WORKSPACE_POINTS];
+
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+
+    sidh_message_digest(digest, message, message_length);
+    returned_value = signature_sign(signature, challenge_bytes, digest, private_key, public_key, state,
+                                    insights, pohlig_hellman);
+    signature_compress(compact_signature, compact_signature_length, signature, challenge_bytes);
+    return returned_value;
+}
+
+uint8_t sidh_signature_compress(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                                uint64_t *compact_signature_length,
+                                const uint8_t signature[SIGNATURE_BYTES],
+                                const uint8_t *message,
+                                uint64_t message_length,
+                                const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    if (message_length == 0) {
+        return EXIT_FAILURE;
+    }
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+
+    sidh_signature_challenge(challenge_bytes, signature, message, message_length, public_key);
+    signature_compress(compact_signature, compact_signature_length, signature, challenge_bytes);
+    return EXIT_SUCCESS;
+}
+
+static uint8_t signature_verify_compact(const uint8_t *compact_signature,
+                                       uint64_t compact_signature_length,
+                                       const uint8_t *message,
+                                       uint64_t message_length,
+                                       const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                       uint8_t commitments[COMMITMENT_BYTES * SECURITY_BITS]) {
+    if (message_length == 0 || compact_signature_length < COMPACT_SIGNATURE_MIN_BYTES) {
+        return EXIT_FAILURE;
+    }
 
-    uint8_t returned_value = 0;
+    uint8_t returned_value = 0, challenge;
     uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
-    uint8_t statement[PUBLIC_KEY_BYTES + (SECURITY_BITS / 8)] = {0};
+    const uint8_t *responses;
+    uint64_t position = SECURITY_BITS / 8, expected_length = COMPACT_SIGNATURE_MIN_BYTES;
 
-    shake256(statement, SECURITY_BITS / 8, message, message_length);
-    memcpy(&statement[SECURITY_BITS / 8], public_key, PUBLIC_KEY_BYTES);
-    sidh_pok_challenge(challenge_bytes, signature, COMMITMENT_BYTES * SECURITY_BITS, statement, sizeof(statement));
+    // The challenge determines the layout, and thus the expected length
+    for (uint8_t i = 0; i < SECURITY_BITS / 8; i++) {
+        for (uint8_t j = 0; j < 8; j++) {
+            if (!((compact_signature[i] >> j) & 1)) { expected_length += PUBLIC_KEY_BYTES; }
+        }
+    }
+    if (compact_signature_length != expected_length) { return EXIT_FAILURE; }
+    responses = &compact_signature[expected_length - (RESPONSE_BYTES * SECURITY_BITS)];
 
     for (uint8_t i = 0; i < SECURITY_BITS / 8; i++) {
         for (uint8_t j = 0; j < 8; j++) {
-            returned_value |= sidh_pok_verification(
-                    &signature[COMMITMENT_BYTES * ((i * 8) + j)],
-                    &signature[(COMMITMENT_BYTES * SECURITY_BITS) + (RESPONSE_BYTES * ((i * 8) + j))],
-                    public_key,
-                    (challenge_bytes[i] >> j) & 1);
+            uint8_t *commit = &commitments[COMMITMENT_BYTES * ((i * 8) + j)];
+            const uint8_t *resp = &responses[RESPONSE_BYTES * ((i * 8) + j)];
+            challenge = (compact_signature[i] >> j) & 1;
+            if (challenge) {
+                memcpy(commit, &compact_signature[position], QUADRATIC_FIELD_BYTES);
+                position += QUADRATIC_FIELD_BYTES;
+                returned_value |= sidh_pok_commitment_recovery(commit, resp);
+            } else {
+                memcpy(commit, &compact_signature[position], COMMITMENT_BYTES);
+                position += COMMITMENT_BYTES;
+                returned_value |= sidh_pok_verification(commit, resp, public_key, challenge);
+            }
         }
     }
 
+    // Recomputed commitments must hash to the challenge the layout was parsed with
+    sidh_signature_challenge(challenge_bytes, commitments, message, message_length, public_key);
+    returned_value |= (uint8_t) (constant_time_compare(challenge_bytes, compact_signature, SECURITY_BITS / 8) != 0);
+
+    return returned_value;
+}
+
+uint8_t sidh_signature_verify_compact(const uint8_t *compact_signature,
+                                      uint64_t compact_signature_length,
+                                      const uint8_t *message,
+                                      uint64_t message_length,
+                                      const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint8_t commitments[COMMITMENT_BYTES * SECURITY_BITS] = {0};
+    return signature_verify_compact(compact_signature, compact_signature_length, message, message_length, public_key,
+                                    commitments);
+}
+
+// ++++++++++++++++++++ Caller-supplied workspace ++++++++++++++++++++
+// Layout: Pohlig-Hellman multiples || insights || signature (or recovered commitments when verifying)
+
+size_t sidh_signature_workspace_bytes(void) {
+    return SIGNATURE_WORKSPACE_BYTES;
+}
+
+static uint8_t workspace_is_valid(const void *workspace, size_t workspace_bytes) {
+    return (workspace != NULL) &&
+           (workspace_bytes >= SIGNATURE_WORKSPACE_BYTES) &&
+           (((uintptr_t) workspace % SIGNATURE_WORKSPACE_ALIGNMENT) == 0);
+}
+
+static sidh_pok_insight_t *workspace_insights(void *workspace) {
+    return (sidh_pok_insight_t *) &((projective_point_t *) workspace)[POHLIG_HELLMAN_WORKSPACE_POINTS];
+}
+
+static uint8_t *workspace_signature(void *workspace) {
+    return (uint8_t *) &workspace_insights(workspace)[SECURITY_BITS];
+}
+
+uint8_t sidh_signature_sign_workspace(uint8_t signature[SIGNATURE_BYTES],
+                                      const uint8_t *message,
+                                      uint64_t message_length,
+                                      const uint8_t private_key[SECRET_KEY_BYTES],
+                                      const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                      keccak_state *state,
+                                      void *workspace,
+                                      size_t workspace_bytes) {
+    if (message_length == 0 || !workspace_is_valid(workspace, workspace_bytes)) {
+        return EXIT_FAILURE;
+    }
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+
+    sidh_message_digest(digest, message, message_length);
+    return signature_sign(signature, challenge_bytes, digest, private_key, public_key, state,
+                          workspace_insights(workspace), (projective_point_t *) workspace);
+}
+
+uint8_t sidh_signature_sign_compact_workspace(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                                              uint64_t *compact_signature_length,
+                                              const uint8_t *message,
+                                              uint64_t message_length,
+                                              const uint8_t private_key[SECRET_KEY_BYTES],
+                                              const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                              keccak_state *state,
+                                              void *workspace,
+                                              size_t workspace_bytes) {
+    if (message_length == 0 || !workspace_is_valid(workspace, workspace_bytes)) {
+        return EXIT_FAILURE;
+    }
+    uint8_t returned_value;
+    uint8_t challenge_bytes[SECURITY_BITS / 8] = {0};
+    uint8_t *signature = workspace_signature(workspace);
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+
+    sidh_message_digest(digest, message, message_length);
+    returned_value = signature_sign(signature, challenge_bytes, digest, private_key, public_key, state,
+                                    workspace_insights(workspace), (projective_point_t *) workspace);
+    signature_compress(compact_signature, compact_signature_length, signature, challenge_bytes);
     return returned_value;
 }
 
+uint8_t sidh_signature_verify_compact_workspace(const uint8_t *compact_signature,
+                                                uint64_t compact_signature_length,
+                                                const uint8_t *message,
+                                                uint64_t message_length,
+                                                const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                                void *workspace,
+                                                size_t workspace_bytes) {
+    if (!workspace_is_valid(workspace, workspace_bytes)) {
+        return EXIT_FAILURE;
+    }
+    return signature_verify_compact(compact_signature, compact_signature_length, message, message_length, public_key,
+                                    workspace_signature(workspace));
+}
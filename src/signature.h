@@ -5,16 +5,50 @@
 #ifndef SIDH_POK_SIGNATURE_H
 #define SIDH_POK_SIGNATURE_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "pok.h"
+#include "digest.h"
 
 #define SECRET_KEY_BYTES    SECRET_KEY_BYTES_ALICE
 #define SIGNATURE_BYTES     ((COMMITMENT_BYTES + RESPONSE_BYTES) * SECURITY_BITS)
 
+// Compact signatures: challenge || commitments || responses, where challenge-1 commitments only carry E₂
+#define COMPACT_SIGNATURE_MIN_BYTES ((SECURITY_BITS / 8) + ((QUADRATIC_FIELD_BYTES + RESPONSE_BYTES) * SECURITY_BITS))
+#define COMPACT_SIGNATURE_MAX_BYTES ((SECURITY_BITS / 8) + SIGNATURE_BYTES)
+
+// Caller-supplied workspace of the *_workspace variants below, so that no large buffer lives on the stack.
+// It holds the Pohlig-Hellman multiples, the insights, and a full signature (compact signing and verification)
+#define SIGNATURE_WORKSPACE_ALIGNMENT   64
+#define SIGNATURE_WORKSPACE_BYTES       ((((POHLIG_HELLMAN_WORKSPACE_POINTS * sizeof(projective_point_t)) +    \
+                                          (SECURITY_BITS * sizeof(sidh_pok_insight_t)) + SIGNATURE_BYTES) +    \
+                                         (SIGNATURE_WORKSPACE_ALIGNMENT - 1)) & ~(size_t)(SIGNATURE_WORKSPACE_ALIGNMENT - 1))
+
+// Fiat-Shamir challenge: SHAKE256(commitments || 0xFF || digest || public key), see sidh_message_digest
+void sidh_signature_challenge_digest(uint8_t challenge_bytes[SECURITY_BITS / 8],
+                                     const uint8_t commitments[COMMITMENT_BYTES * SECURITY_BITS],
+                                     const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                     const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+void sidh_signature_challenge(uint8_t challenge_bytes[SECURITY_BITS / 8],
+                              const uint8_t commitments[COMMITMENT_BYTES * SECURITY_BITS],
+                              const uint8_t *message,
+                              uint64_t message_length,
+                              const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
 uint8_t sidh_signature_key_generation(uint8_t private_key_bytes[SECRET_KEY_BYTES],
                                       uint8_t public_key_bytes[PUBLIC_KEY_BYTES],
                                       keccak_state *state);
 
+// Keys i = 0 .. number_of_keys - 1 at SECRET_KEY_BYTES * i and PUBLIC_KEY_BYTES * i, equal to those of as many
+// sidh_signature_key_generation calls on the same state. The batch shares a fixed-base table of the 2ᵃ-generator
+// and a single inversion, and splits the isogeny walks across threads (zero means one per online core)
+uint8_t sidh_signature_key_generation_batch(uint8_t *private_keys_bytes,
+                                            uint8_t *public_keys_bytes,
+                                            uint64_t number_of_keys,
+                                            keccak_state *state,
+                                            unsigned int number_of_threads);
+
 uint8_t sidh_signature_sign(uint8_t signature[SIGNATURE_BYTES],
                             const uint8_t *message,
                             uint64_t message_length,
@@ -27,4 +61,116 @@ uint8_t sidh_signature_verify(const uint8_t signature[SIGNATURE_BYTES],
                               uint64_t message_length,
                               const uint8_t public_key[SECRET_KEY_BYTES]);
 
+// Streaming: the message is hashed beforehand with sidh_message_digest_init/update/final, which refuses an empty
+// message as sidh_signature_sign does
+uint8_t sidh_signature_sign_digest(uint8_t signature[SIGNATURE_BYTES],
+                                   const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                   const uint8_t private_key[SECRET_KEY_BYTES],
+                                   const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                   keccak_state *state);
+
+uint8_t sidh_signature_verify_digest(const uint8_t signature[SIGNATURE_BYTES],
+                                     const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                     const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+// Public key decoded once: its bytes (hashed into the challenge) and its curve coefficient A in Montgomery form.
+// valid is set when the x-coordinates are non-zero and the curve is non-singular
+typedef struct {
+    quadratic_field_element_t A;
+    uint8_t public_key[PUBLIC_KEY_BYTES];
+    uint8_t valid;
+} sidh_prepared_public_key_t;
+
+uint8_t sidh_signature_prepare_public_key(sidh_prepared_public_key_t *prepared,
+                                         const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+// Fail-fast verification against a prepared key; keys not marked valid are rejected
+uint8_t sidh_signature_verify_prepared(const uint8_t signature[SIGNATURE_BYTES],
+                                       const uint8_t *message,
+                                       uint64_t message_length,
+                                       const sidh_prepared_public_key_t *public_key);
+
+// Same result as sidh_signature_verify, but cheap rounds first and an early exit on the first failed round,
+// so that forged signatures are rejected at a fraction of the cost of a full verification
+uint8_t sidh_signature_verify_fail_fast(const uint8_t signature[SIGNATURE_BYTES],
+                                        const uint8_t *message,
+                                        uint64_t message_length,
+                                        const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+// Incremental verification of a signature received in chunks of any size. The challenge-independent work of a round
+// (decoding E₂ and E₃, and the canonical basis of E₂) runs as soon as its commitment is complete, overlapping the
+// transfer of the rest; the responses are checked by sidh_signature_verifier_final. The state is large (a full
+// signature and a precomputation per round), so it should not live on the stack
+typedef struct {
+    sidh_prepared_public_key_t public_key;
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+    uint8_t signature[SIGNATURE_BYTES];
+    uint64_t received;                                  // signature bytes so far
+    uint16_t precomputed;                               // rounds whose commitment went through the precomputation
+    uint8_t failed;                                     // invalid public key, or too many bytes
+    sidh_pok_precomputation_t rounds[SECURITY_BITS];
+} sidh_signature_verifier_t;
+
+// The message is hashed beforehand with sidh_message_digest (or sidh_message_digest_init/update/final)
+uint8_t sidh_signature_verifier_init(sidh_signature_verifier_t *verifier,
+                                     const uint8_t digest[MESSAGE_DIGEST_BYTES],
+                                     const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+uint8_t sidh_signature_verifier_update(sidh_signature_verifier_t *verifier, const uint8_t *chunk, uint64_t chunk_length);
+
+// Same result as sidh_signature_verify_digest on the concatenated chunks; invalid public keys are rejected
+uint8_t sidh_signature_verifier_final(sidh_signature_verifier_t *verifier);
+
+uint8_t sidh_signature_sign_compact(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                                    uint64_t *compact_signature_length,
+                                    const uint8_t *message,
+                                    uint64_t message_length,
+                                    const uint8_t private_key[SECRET_KEY_BYTES],
+                                    const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                    keccak_state *state);
+
+uint8_t sidh_signature_compress(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                                uint64_t *compact_signature_length,
+                                const uint8_t signature[SIGNATURE_BYTES],
+                                const uint8_t *message,
+                                uint64_t message_length,
+                                const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+uint8_t sidh_signature_verify_compact(const uint8_t *compact_signature,
+                                      uint64_t compact_signature_length,
+                                      const uint8_t *message,
+                                      uint64_t message_length,
+                                      const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+size_t sidh_signature_workspace_bytes(void);
+
+// The workspace must be SIGNATURE_WORKSPACE_ALIGNMENT-aligned with at least sidh_signature_workspace_bytes() bytes;
+// it can be reused between calls. sidh_signature_verify does not need one.
+uint8_t sidh_signature_sign_workspace(uint8_t signature[SIGNATURE_BYTES],
+                                      const uint8_t *message,
+                                      uint64_t message_length,
+                                      const uint8_t private_key[SECRET_KEY_BYTES],
+                                      const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                      keccak_state *state,
+                                      void *workspace,
+                                      size_t workspace_bytes);
+
+uint8_t sidh_signature_sign_compact_workspace(uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES],
+                                              uint64_t *compact_signature_length,
+                                              const uint8_t *message,
+                                              uint64_t message_length,
+                                              const uint8_t private_key[SECRET_KEY_BYTES],
+                                              const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                              keccak_state *state,
+                                              void *workspace,
+                                              size_t workspace_bytes);
+
+uint8_t sidh_signature_verify_compact_workspace(const uint8_t *compact_signature,
+                                                uint64_t compact_signature_length,
+                                                const uint8_t *message,
+                                                uint64_t message_length,
+                                                const uint8_t public_key[PUBLIC_KEY_BYTES],
+                                                void *workspace,
+                                                size_t workspace_bytes);
+
 #endif //SIDH_POK_SIGNATURE_H
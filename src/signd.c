@@ -0,0 +1,82 @@
+//
+// sidh-signd: serves one signing key over a UNIX domain socket until SIGINT or SIGTERM
+//
+// Usage: sidh-signd-p<P> <socket path> <key file> [threads]
+// The key file holds private key || public key; it is generated when missing.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "daemon.h"
+
+static uint8_t load_or_generate_key(const char *path, sidh_daemon_key_t *key) {
+    uint8_t seed[SECURITY_BITS / 8];
+    keccak_state state;
+    ssize_t length;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        length = read(fd, key, sizeof(sidh_daemon_key_t));
+        close(fd);
+        return (length == (ssize_t) sizeof(sidh_daemon_key_t)) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0) { return EXIT_FAILURE; }
+    length = read(fd, seed, sizeof(seed));
+    close(fd);
+    if (length != (ssize_t) sizeof(seed)) { return EXIT_FAILURE; }
+    shake256_init(&state);
+    shake256_absorb(&state, seed, sizeof(seed));
+    shake256_finalize(&state);
+    if (sidh_signature_key_generation(key->private_key, key->public_key, &state) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+    }
+
+    fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) { return EXIT_FAILURE; }
+    length = write(fd, key, sizeof(sidh_daemon_key_t));
+    close(fd);
+    return (length == (ssize_t) sizeof(sidh_daemon_key_t)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+    sidh_daemon_key_t key;
+    sidh_daemon_stats_t stats;
+    sidh_daemon_t *daemon;
+    sigset_t signals;
+    int signal_number;
+
+    if (argc < 3 || argc > 4) {
+        fprintf(stderr, "Usage: %s <socket path> <key file> [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (load_or_generate_key(argv[2], &key) == EXIT_FAILURE) {
+        fprintf(stderr, "Cannot load or generate the key file %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    // Blocked before any thread starts, so only sigwait sees them
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    daemon = sidh_daemon_start(argv[1], &key, 1, (argc == 4) ? (unsigned int) strtoul(argv[3], NULL, 10) : 0);
+    if (daemon == NULL) {
+        fprintf(stderr, "Cannot listen on %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    sigwait(&signals, &signal_number);
+
+    sidh_daemon_get_stats(daemon, &stats);
+    sidh_daemon_stop(daemon);
+    fprintf(stderr, "%lu requests, average latency %lu us, maximum latency %lu us\n",
+            (unsigned long) stats.completed, (unsigned long) stats.average_latency_us,
+            (unsigned long) stats.maximum_latency_us);
+    return EXIT_SUCCESS;
+}
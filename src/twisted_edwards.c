@@ -297,18 +297,19 @@ void pohlig_hellman_steps_bob(projective_point_t *T,
     }
 }
 
-void two_dimensional_pohlig_hellman_bob(uint64_t output_c[SUBGROUP_ORDER_64BITS_WORDS],
-                                        uint64_t output_d[SUBGROUP_ORDER_64BITS_WORDS],
-                                        projective_point_t input_K,
-                                        projective_point_t input_P,
-                                        projective_point_t input_Q,
-                                        twisted_edwards_curve_t curve) {
+void two_dimensional_pohlig_hellman_bob_workspace(uint64_t output_c[SUBGROUP_ORDER_64BITS_WORDS],
+                                                  uint64_t output_d[SUBGROUP_ORDER_64BITS_WORDS],
+                                                  projective_point_t input_K,
+                                                  projective_point_t input_P,
+                                                  projective_point_t input_Q,
+                                                  twisted_edwards_curve_t curve,
+                                                  projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]) {
     uint8_t i, row, strategy_step, index = 0,
             strategy_indexes[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB],
             number_of_points = 0, strategy_position = 0;
 
     uint64_t monomial[SUBGROUP_ORDER_64BITS_WORDS] = {0}, coefficient[SUBGROUP_ORDER_64BITS_WORDS] = {0};
-    projective_point_t P_multiples[EXPONENT_BOB], Q_multiples[EXPONENT_BOB], table[4], R, T,
+    projective_point_t *P_multiples = workspace, *Q_multiples = &workspace[EXPONENT_BOB], table[4], R, T,
             strategy_points[STRATEGY_MAXIMUM_INTERNAL_POINTS_BOB];
 
     memset(output_c, 0, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
@@ -386,6 +387,16 @@ void two_dimensional_pohlig_hellman_bob(uint64_t output_c[SUBGROUP_ORDER_64BITS_
                             coefficient);
 }
 
+void two_dimensional_pohlig_hellman_bob(uint64_t output_c[SUBGROUP_ORDER_64BITS_WORDS],
+                                        uint64_t output_d[SUBGROUP_ORDER_64BITS_WORDS],
+                                        projective_point_t input_K,
+                                        projective_point_t input_P,
+                                        projective_point_t input_Q,
+                                        twisted_edwards_curve_t curve) {
+    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS];
+    two_dimensional_pohlig_hellman_bob_workspace(output_c, output_d, input_K, input_P, input_Q, curve, workspace);
+}
+
 void to_twisted_edwards_model(projective_point_t *output,
                               quadratic_field_element_t input_x,
                               quadratic_field_element_t input_y) {
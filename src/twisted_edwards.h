@@ -31,7 +31,26 @@ void projective_point_doubling(projective_point_t *output,
                                projective_point_t input_P,
                                quadratic_field_element_t input_a);
 
+// One strategy leaf of the 2D Pohlig-Hellman: T ← T - [cᵢ]P - [dᵢ]Q for the digits (cᵢ, dᵢ) determined by R and table
+void pohlig_hellman_steps_bob(projective_point_t *T,
+                              projective_point_t P,
+                              projective_point_t Q,
+                              projective_point_t R,
+                              const projective_point_t table[4],
+                              twisted_edwards_curve_t curve);
+
+// Precomputed multiples [3ⁱ]P and [3ⁱ]Q of the 2D Pohlig-Hellman
+#define POHLIG_HELLMAN_WORKSPACE_POINTS (2 * EXPONENT_BOB)
+
 // We assume P and Q generates all E[3ᵇ]
+void two_dimensional_pohlig_hellman_bob_workspace(uint64_t output_c[SUBGROUP_ORDER_64BITS_WORDS],
+                                                  uint64_t output_d[SUBGROUP_ORDER_64BITS_WORDS],
+                                                  projective_point_t input_K,
+                                                  projective_point_t input_P,
+                                                  projective_point_t input_Q,
+                                                  twisted_edwards_curve_t curve,
+                                                  projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS]);
+
 void two_dimensional_pohlig_hellman_bob(uint64_t output_c[SUBGROUP_ORDER_64BITS_WORDS],
                                         uint64_t output_d[SUBGROUP_ORDER_64BITS_WORDS],
                                         projective_point_t input_K,
@@ -2,6 +2,7 @@
 // Utility functions: 64-bits built-in functions
 //
 
+#include <stdlib.h>
 #include <string.h>
 #include "utilities.h"
 
@@ -114,8 +115,81 @@ uint8_t multiprecision_is_smaller(const uint64_t *input1, const uint64_t *input2
     uint64_t ret = 0, tmp, condition[input_length];
     multiprecision_subtraction(condition, input1, input2, input_length);
     tmp = input1[input_length - 1] ^ input2[input_length - 1];
-    condition[input_length - 1] ^= tmp & (condition[input_length - 1] ^ input1[input_length - 1]);
+    // Borrow out of the most significant word: (¬a ∧ b) ∨ (¬(a ⊕ b) ∧ (a - b)), also for full 64-bit words
+    condition[input_length - 1] = (~input1[input_length - 1] & input2[input_length - 1]) |
+                                  (~tmp & condition[input_length - 1]);
     condition[input_length - 1] >>= 63;
     ret |= condition[input_length - 1];
     return ret;
 }
+
+static uint8_t multiprecision_is_equal_to_u64(const uint64_t *input, uint64_t input_value, uint64_t input_length) {
+    uint64_t i, t = input[0] ^ input_value;
+    for (i = 1; i < input_length; i++) {
+        t |= input[i];
+    }
+    return (uint8_t) (t == 0);
+}
+
+// x/2 mod m, assuming m is odd and there is room for x + m
+static void multiprecision_modular_halving(uint64_t *input_output_x, const uint64_t *input_modulus, uint64_t input_length) {
+    if (input_output_x[0] & 1) {
+        multiprecision_addition(input_output_x, input_output_x, input_modulus, input_length);
+    }
+    multiprecision_shift_to_right(input_output_x, input_length);
+}
+
+// x - y mod m with x and y in [0, m)
+static void multiprecision_modular_subtraction(uint64_t *input_output_x,
+                                               const uint64_t *input_y,
+                                               const uint64_t *input_modulus,
+                                               uint64_t input_length) {
+    if (multiprecision_is_smaller(input_output_x, input_y, input_length)) {
+        multiprecision_addition(input_output_x, input_output_x, input_modulus, input_length);
+    }
+    multiprecision_subtraction(input_output_x, input_output_x, input_y, input_length);
+}
+
+// Binary extended gcd (non-constant-time): output = b/a mod m for an odd modulus m, and a, b in [0, m)
+uint8_t multiprecision_modular_division(uint64_t *output,
+                                        const uint64_t *input_a,
+                                        const uint64_t *input_b,
+                                        const uint64_t *input_modulus,
+                                        uint64_t input_length) {
+    uint64_t u[input_length], v[input_length], x1[input_length], x2[input_length];
+
+    memcpy(u, input_a, sizeof(uint64_t) * input_length);
+    memcpy(v, input_modulus, sizeof(uint64_t) * input_length);
+    memcpy(x1, input_b, sizeof(uint64_t) * input_length);
+    memset(x2, 0, sizeof(uint64_t) * input_length);
+
+    // Invariants: a·x1 = b·u and a·x2 = b·v modulo m
+    while (!multiprecision_is_equal_to_u64(u, 1, input_length) && !multiprecision_is_equal_to_u64(v, 1, input_length)) {
+        // gcd(a, m) ≠ 1
+        if (multiprecision_is_equal_to_u64(u, 0, input_length)) { return EXIT_FAILURE; }
+        if (multiprecision_is_equal_to_u64(v, 0, input_length)) { return EXIT_FAILURE; }
+
+        while ((u[0] & 1) == 0) {
+            multiprecision_shift_to_right(u, input_length);
+            multiprecision_modular_halving(x1, input_modulus, input_length);
+        }
+        while ((v[0] & 1) == 0) {
+            multiprecision_shift_to_right(v, input_length);
+            multiprecision_modular_halving(x2, input_modulus, input_length);
+        }
+        if (!multiprecision_is_smaller(u, v, input_length)) {
+            multiprecision_subtraction(u, u, v, input_length);
+            multiprecision_modular_subtraction(x1, x2, input_modulus, input_length);
+        } else {
+            multiprecision_subtraction(v, v, u, input_length);
+            multiprecision_modular_subtraction(x2, x1, input_modulus, input_length);
+        }
+    }
+
+    if (multiprecision_is_equal_to_u64(u, 1, input_length)) {
+        memcpy(output, x1, sizeof(uint64_t) * input_length);
+    } else {
+        memcpy(output, x2, sizeof(uint64_t) * input_length);
+    }
+    return EXIT_SUCCESS;
+}
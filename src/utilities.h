@@ -50,4 +50,11 @@ multiprecision_subtraction(uint64_t *output, const uint64_t *input_a, const uint
 
 uint8_t multiprecision_is_smaller(const uint64_t *input1, const uint64_t *input2, uint64_t input_length);
 
+// Requires an odd modulus and a few spare bits in the top word
+uint8_t multiprecision_modular_division(uint64_t *output,
+                                        const uint64_t *input_a,
+                                        const uint64_t *input_b,
+                                        const uint64_t *input_modulus,
+                                        uint64_t input_length);
+
 #endif //SIDH_POK_UTILITIES_H
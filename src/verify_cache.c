@@ -0,0 +1,206 @@
+//
+// Bounded, thread-safe cache of verified signatures with LRU eviction
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "verify_cache.h"
+
+#define VERIFY_CACHE_NONE UINT32_MAX
+
+// Entries live in one preallocated array; links are indices into it
+typedef struct {
+    uint8_t key[VERIFY_CACHE_KEY_BYTES];
+    uint32_t bucket_next;
+    uint32_t newer;
+    uint32_t older;
+} verify_cache_entry_t;
+
+struct sidh_verify_cache {
+    pthread_mutex_t lock;
+    verify_cache_entry_t *entries;
+    uint32_t *buckets;
+    uint32_t capacity;
+    uint32_t mask;                      // buckets - 1, at least twice the capacity
+    uint32_t used;
+    uint32_t newest;
+    uint32_t oldest;
+    sidh_verify_cache_stats_t stats;
+};
+
+static uint32_t *verify_cache_bucket(sidh_verify_cache_t *cache, const uint8_t key[VERIFY_CACHE_KEY_BYTES]) {
+    uint32_t index;
+
+    memcpy(&index, key, sizeof(index));
+    return &cache->buckets[index & cache->mask];
+}
+
+static void verify_cache_unlink(sidh_verify_cache_t *cache, uint32_t index) {
+    verify_cache_entry_t *entry = &cache->entries[index];
+
+    if (entry->newer != VERIFY_CACHE_NONE) { cache->entries[entry->newer].older = entry->older; }
+    else { cache->newest = entry->older; }
+    if (entry->older != VERIFY_CACHE_NONE) { cache->entries[entry->older].newer = entry->newer; }
+    else { cache->oldest = entry->newer; }
+}
+
+static void verify_cache_push_newest(sidh_verify_cache_t *cache, uint32_t index) {
+    verify_cache_entry_t *entry = &cache->entries[index];
+
+    entry->newer = VERIFY_CACHE_NONE;
+    entry->older = cache->newest;
+    if (cache->newest != VERIFY_CACHE_NONE) { cache->entries[cache->newest].newer = index; }
+    cache->newest = index;
+    if (cache->oldest == VERIFY_CACHE_NONE) { cache->oldest = index; }
+}
+
+// Call with the lock held
+static uint32_t verify_cache_find(sidh_verify_cache_t *cache, const uint8_t key[VERIFY_CACHE_KEY_BYTES]) {
+    uint32_t index = *verify_cache_bucket(cache, key);
+
+    while (index != VERIFY_CACHE_NONE && memcmp(cache->entries[index].key, key, VERIFY_CACHE_KEY_BYTES) != 0) {
+        index = cache->entries[index].bucket_next;
+    }
+    return index;
+}
+
+sidh_verify_cache_t *sidh_verify_cache_create(size_t memory_limit_bytes) {
+    sidh_verify_cache_t *cache;
+    size_t capacity = 0, buckets = 0, fit, size;
+
+    if (memory_limit_bytes < sizeof(sidh_verify_cache_t)) { return NULL; }
+    memory_limit_bytes -= sizeof(sidh_verify_cache_t);
+
+    // Largest capacity whose entries and power-of-two table (load at most 1/2) fit in the limit
+    for (size = 2; size * sizeof(uint32_t) < memory_limit_bytes && size <= VERIFY_CACHE_NONE / 2; size *= 2) {
+        fit = (memory_limit_bytes - size * sizeof(uint32_t)) / sizeof(verify_cache_entry_t);
+        fit = (fit < size / 2) ? fit : size / 2;
+        if (fit > capacity) {
+            capacity = fit;
+            buckets = size;
+        }
+    }
+    if (capacity == 0) { return NULL; }
+
+    cache = calloc(1, sizeof(sidh_verify_cache_t));
+    if (cache == NULL) { return NULL; }
+    cache->entries = malloc(capacity * sizeof(verify_cache_entry_t));
+    cache->buckets = malloc(buckets * sizeof(uint32_t));
+    if (cache->entries == NULL || cache->buckets == NULL) {
+        free(cache->entries);
+        free(cache->buckets);
+        free(cache);
+        return NULL;
+    }
+    memset(cache->buckets, 0xFF, buckets * sizeof(uint32_t));
+    cache->capacity = (uint32_t) capacity;
+    cache->mask = (uint32_t) (buckets - 1);
+    cache->newest = VERIFY_CACHE_NONE;
+    cache->oldest = VERIFY_CACHE_NONE;
+    cache->stats.capacity = capacity;
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+void sidh_verify_cache_destroy(sidh_verify_cache_t *cache) {
+    if (cache == NULL) { return; }
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+}
+
+void sidh_verify_cache_key(uint8_t key[VERIFY_CACHE_KEY_BYTES],
+                           const uint8_t signature[SIGNATURE_BYTES],
+                           const uint8_t *message,
+                           uint64_t message_length,
+                           const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+    keccak_state state;
+
+    sidh_message_digest(digest, message, message_length);
+    shake256_init(&state);
+    shake256_absorb(&state, digest, MESSAGE_DIGEST_BYTES);
+    shake256_absorb(&state, public_key, PUBLIC_KEY_BYTES);
+    shake256_absorb(&state, signature, SIGNATURE_BYTES);
+    shake256_finalize(&state);
+    shake256_squeeze(key, VERIFY_CACHE_KEY_BYTES, &state);
+}
+
+uint8_t sidh_verify_cache_lookup(sidh_verify_cache_t *cache, const uint8_t key[VERIFY_CACHE_KEY_BYTES]) {
+    uint32_t index;
+
+    pthread_mutex_lock(&cache->lock);
+    index = verify_cache_find(cache, key);
+    if (index != VERIFY_CACHE_NONE) {
+        verify_cache_unlink(cache, index);
+        verify_cache_push_newest(cache, index);
+        cache->stats.hits++;
+    } else {
+        cache->stats.misses++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return index != VERIFY_CACHE_NONE;
+}
+
+void sidh_verify_cache_insert(sidh_verify_cache_t *cache, const uint8_t key[VERIFY_CACHE_KEY_BYTES]) {
+    uint32_t index, *link;
+
+    pthread_mutex_lock(&cache->lock);
+    // Concurrent misses on the same tuple insert it once
+    if (verify_cache_find(cache, key) != VERIFY_CACHE_NONE) {
+        pthread_mutex_unlock(&cache->lock);
+        return;
+    }
+
+    if (cache->used < cache->capacity) {
+        index = cache->used++;
+    } else {
+        // Evict the least recently used entry
+        index = cache->oldest;
+        verify_cache_unlink(cache, index);
+        link = verify_cache_bucket(cache, cache->entries[index].key);
+        while (*link != index) { link = &cache->entries[*link].bucket_next; }
+        *link = cache->entries[index].bucket_next;
+        cache->stats.evictions++;
+    }
+
+    memcpy(cache->entries[index].key, key, VERIFY_CACHE_KEY_BYTES);
+    link = verify_cache_bucket(cache, key);
+    cache->entries[index].bucket_next = *link;
+    *link = index;
+    verify_cache_push_newest(cache, index);
+    cache->stats.insertions++;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+uint8_t sidh_verify_cache_verify(sidh_verify_cache_t *cache,
+                                 const uint8_t signature[SIGNATURE_BYTES],
+                                 const uint8_t *message,
+                                 uint64_t message_length,
+                                 const uint8_t public_key[PUBLIC_KEY_BYTES]) {
+    uint8_t key[VERIFY_CACHE_KEY_BYTES];
+
+    if (message_length == 0) {
+        return EXIT_FAILURE;
+    }
+    sidh_verify_cache_key(key, signature, message, message_length, public_key);
+    if (sidh_verify_cache_lookup(cache, key)) {
+        return EXIT_SUCCESS;
+    }
+
+    // The lock is not held while verifying
+    if (sidh_signature_verify_fail_fast(signature, message, message_length, public_key) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    sidh_verify_cache_insert(cache, key);
+    return EXIT_SUCCESS;
+}
+
+void sidh_verify_cache_get_stats(sidh_verify_cache_t *cache, sidh_verify_cache_stats_t *stats) {
+    pthread_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    stats->entries = cache->used;
+    pthread_mutex_unlock(&cache->lock);
+}
@@ -0,0 +1,52 @@
+//
+// Bounded, thread-safe cache of verified signatures with LRU eviction
+//
+
+#ifndef SIDH_POK_VERIFY_CACHE_H
+#define SIDH_POK_VERIFY_CACHE_H
+
+#include <stddef.h>
+#include "signature.h"
+
+// Entries are keyed by SHAKE256(message digest || public key || signature)
+#define VERIFY_CACHE_KEY_BYTES  32
+
+typedef struct sidh_verify_cache sidh_verify_cache_t;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t capacity;
+} sidh_verify_cache_stats_t;
+
+// The entries, the hash table and the LRU links fit in memory_limit_bytes; NULL if not even one entry fits
+sidh_verify_cache_t *sidh_verify_cache_create(size_t memory_limit_bytes);
+
+void sidh_verify_cache_destroy(sidh_verify_cache_t *cache);
+
+// A hit costs one hash of the tuple; a miss runs sidh_signature_verify_fail_fast and caches valid signatures only
+uint8_t sidh_verify_cache_verify(sidh_verify_cache_t *cache,
+                                 const uint8_t signature[SIGNATURE_BYTES],
+                                 const uint8_t *message,
+                                 uint64_t message_length,
+                                 const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+void sidh_verify_cache_get_stats(sidh_verify_cache_t *cache, sidh_verify_cache_stats_t *stats);
+
+// Lower-level interface for callers running the verification themselves (for example through the engine)
+void sidh_verify_cache_key(uint8_t key[VERIFY_CACHE_KEY_BYTES],
+                           const uint8_t signature[SIGNATURE_BYTES],
+                           const uint8_t *message,
+                           uint64_t message_length,
+                           const uint8_t public_key[PUBLIC_KEY_BYTES]);
+
+// 1 if the key is cached (and marks it most recently used)
+uint8_t sidh_verify_cache_lookup(sidh_verify_cache_t *cache, const uint8_t key[VERIFY_CACHE_KEY_BYTES]);
+
+// Only keys of successfully verified signatures may be inserted
+void sidh_verify_cache_insert(sidh_verify_cache_t *cache, const uint8_t key[VERIFY_CACHE_KEY_BYTES]);
+
+#endif //SIDH_POK_VERIFY_CACHE_H
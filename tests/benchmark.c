@@ -8,13 +8,20 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <math.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
 #include "benchmark.h"
 #include "test_utils.h"
 
 #define NSEC_PER_SEC 1000000000
-#define BENCHMARK_LOG_LEVEL MUNIT_LOG_INFO
-#define BENCHMARK_LOG_FILE NULL
 #define BENCHMARK_LEFT_PAD ""
 #define BENCHMARK_DEFAULT_ITERATIONS 10
 #define BENCHMARK_DEFAULT_MESSAGE_LEN 64
@@ -92,12 +99,74 @@ static double timespec_to_double(const tspec_t *ts) {
 static uint64_t average(const uint64_t *list, const size_t len) {
     uint64_t acc = 0;
     size_t i;
+    if (len == 0) {
+        return 0;
+    }
     for (i = 0; i < len; i++) {
         acc += list[i];
     }
     return acc / (len);
 }
 
+/*
+ * Latency histogram
+ */
+
+// HDR-style: each power of two is split into HISTOGRAM_SUB_BUCKETS linear buckets, so a value is known to within
+// 1/128 of itself whatever its magnitude, and values below 128 exactly
+#define HISTOGRAM_SUB_BITS      7
+#define HISTOGRAM_SUB_BUCKETS   (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS       ((64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+typedef struct {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+} histogram_t;
+
+static size_t histogram_index(uint64_t value) {
+    int exponent;
+    if (value < HISTOGRAM_SUB_BUCKETS) {
+        return value;
+    }
+    exponent = 63 - __builtin_clzll(value);
+    return (exponent - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS +
+           ((value >> (exponent - HISTOGRAM_SUB_BITS)) - HISTOGRAM_SUB_BUCKETS);
+}
+
+// Largest value sharing the bucket (the last bucket wraps around to UINT64_MAX)
+static uint64_t histogram_highest(size_t index) {
+    size_t shift;
+    if (index < HISTOGRAM_SUB_BUCKETS) {
+        return index;
+    }
+    shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+    return (((uint64_t) (index % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS + 1)) << shift) - 1;
+}
+
+static void histogram_record(histogram_t *histogram, uint64_t value) {
+    histogram->counts[histogram_index(value)]++;
+    histogram->total++;
+    histogram->max = (value > histogram->max) ? value : histogram->max;
+}
+
+// Smallest recorded value (to the bucket precision) with at least percentile % of the samples at or below it
+static uint64_t histogram_percentile(const histogram_t *histogram, double percentile) {
+    uint64_t rank = (uint64_t) ceil(percentile * (double) histogram->total / 100), count = 0;
+    size_t i;
+    uint64_t highest;
+
+    rank = (rank == 0) ? 1 : rank;
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        count += histogram->counts[i];
+        if (count >= rank) {
+            highest = histogram_highest(i);
+            return (highest < histogram->max) ? highest : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
 static void timespec_normalise(tspec_t *ts) {
     while (ts->tv_nsec >= NSEC_PER_SEC) {
         ++(ts->tv_sec);
@@ -207,47 +276,90 @@ int cmp_timespec(const void *a, const void *b)
 }
 
 static void print_report(const char *title, uint64_t *cycles, const size_t len, const tspec_t *running_time, tspec_t *times) {
-#if defined(_P377_)
-    char *prime = "p377";
-#elif defined(_P434_)
-    char * prime = "p434";
-#elif defined(_P503_)
-    char * prime = "p503";
-#elif defined(_P546_)
-    char * prime = "p546";
-#elif defined(_P610_)
-    char * prime = "p610";
-#elif defined(_P697_)
-    char * prime = "p697";
-#elif defined(_P751_)
-    char * prime = "p751";
-#else
-    char * prime = "p434";
-#endif
+    // Reported on top of the tail statistics in long-run mode
+    const double distribution[] = {50, 75, 95, 99.99};
+    const double tail[] = {90, 99, 99.9};
+    benchmark_summary_t summary;
+    histogram_t *histogram_cycles = calloc(1, sizeof(histogram_t));
+    histogram_t *histogram_time = calloc(1, sizeof(histogram_t));
+    size_t i;
+
+    if (histogram_cycles == NULL || histogram_time == NULL) {
+        free(histogram_cycles);
+        free(histogram_time);
+        return;
+    }
+    // Times in nanoseconds
+    for (i = 0; i < len; i++) {
+        histogram_record(histogram_cycles, cycles[i]);
+        histogram_record(histogram_time, (uint64_t) times[i].tv_sec * NSEC_PER_SEC + (uint64_t) times[i].tv_nsec);
+    }
+
+    benchmark_summary_init(&summary, title, len);
+    summary.seconds[BENCHMARK_Q1] = first_quartile_time(times, len);
+    summary.seconds[BENCHMARK_MEDIAN] = median_time(times, len);
+    summary.seconds[BENCHMARK_Q3] = third_quartile_time(times, len);
+    summary.seconds[BENCHMARK_AVERAGE] = timespec_to_double(running_time) / (double) len;
+    summary.cycles[BENCHMARK_Q1] = first_quartile(cycles, len);
+    summary.cycles[BENCHMARK_MEDIAN] = median(cycles, len);
+    summary.cycles[BENCHMARK_Q3] = third_quartile(cycles, len);
+    summary.cycles[BENCHMARK_AVERAGE] = average(cycles, len);
+    for (i = 0; i < 3; i++) {
+        summary.seconds[BENCHMARK_P90 + i] = (double) histogram_percentile(histogram_time, tail[i]) / NSEC_PER_SEC;
+        summary.cycles[BENCHMARK_P90 + i] = histogram_percentile(histogram_cycles, tail[i]);
+    }
+    summary.seconds[BENCHMARK_MAX] = (double) histogram_time->max / NSEC_PER_SEC;
+    summary.cycles[BENCHMARK_MAX] = histogram_cycles->max;
+
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %s %s with %zu iterations", BENCHMARK_LEFT_PAD,
-                  title, prime,
+                  title, summary.prime,
                   len);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf \t\t seconds (total)", BENCHMARK_LEFT_PAD,
                   timespec_to_double(running_time));
 
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [Q1]", BENCHMARK_LEFT_PAD,
-                  first_quartile_time(times, len));
+                  summary.seconds[BENCHMARK_Q1]);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [median]", BENCHMARK_LEFT_PAD,
-                  median_time(times, len));
+                  summary.seconds[BENCHMARK_MEDIAN]);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [Q3]", BENCHMARK_LEFT_PAD,
-                  third_quartile_time(times, len));
+                  summary.seconds[BENCHMARK_Q3]);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf \t\t seconds [average]",
-                  BENCHMARK_LEFT_PAD, timespec_to_double(running_time) / (double) len);
+                  BENCHMARK_LEFT_PAD, summary.seconds[BENCHMARK_AVERAGE]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [p90]", BENCHMARK_LEFT_PAD,
+                  summary.seconds[BENCHMARK_P90]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [p99]", BENCHMARK_LEFT_PAD,
+                  summary.seconds[BENCHMARK_P99]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [p99.9]", BENCHMARK_LEFT_PAD,
+                  summary.seconds[BENCHMARK_P999]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t seconds [max]", BENCHMARK_LEFT_PAD,
+                  summary.seconds[BENCHMARK_MAX]);
 
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [Q1]", BENCHMARK_LEFT_PAD,
-                  first_quartile(cycles, len));
+                  summary.cycles[BENCHMARK_Q1]);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [median]", BENCHMARK_LEFT_PAD,
-                  median(cycles, len));
+                  summary.cycles[BENCHMARK_MEDIAN]);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [Q3]", BENCHMARK_LEFT_PAD,
-                  third_quartile(cycles, len));
+                  summary.cycles[BENCHMARK_Q3]);
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [average]", BENCHMARK_LEFT_PAD,
-                  average(cycles, len - 1));
+                  summary.cycles[BENCHMARK_AVERAGE]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [p90]", BENCHMARK_LEFT_PAD,
+                  summary.cycles[BENCHMARK_P90]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [p99]", BENCHMARK_LEFT_PAD,
+                  summary.cycles[BENCHMARK_P99]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [p99.9]", BENCHMARK_LEFT_PAD,
+                  summary.cycles[BENCHMARK_P999]);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [max]", BENCHMARK_LEFT_PAD,
+                  summary.cycles[BENCHMARK_MAX]);
+    if (benchmark_long_run() > 0) {
+        for (i = 0; i < sizeof(distribution) / sizeof(distribution[0]); i++) {
+            munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %" PRIu64 "\t\t cycles [p%g]",
+                          BENCHMARK_LEFT_PAD, histogram_percentile(histogram_cycles, distribution[i]), distribution[i]);
+        }
+    }
     munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, " ");
+    benchmark_record(&summary);
+    free(histogram_cycles);
+    free(histogram_time);
 }
 
 
@@ -255,8 +367,12 @@ void *benchmark_setup(const MunitParameter params[], MUNIT_UNUSED void *user_dat
 
     benchmark_data_t *data = (benchmark_data_t *) munit_malloc(sizeof(benchmark_data_t));
 
-    data->iterations = get_iterations(params);
+    data->iterations = get_iterations(params) + benchmark_warmup();
     data->message_num_bytes = get_message_num_bytes(params);
+    data->cycles_start = (uint64_t *) munit_malloc(sizeof(uint64_t) * (size_t) data->iterations);
+    data->cycles_stop = (uint64_t *) munit_malloc(sizeof(uint64_t) * (size_t) data->iterations);
+    data->time_start = (tspec_t *) munit_malloc(sizeof(tspec_t) * (size_t) data->iterations);
+    data->time_stop = (tspec_t *) munit_malloc(sizeof(tspec_t) * (size_t) data->iterations);
 
     munit_rand_memory(KECCAK_SEED_LEN, (uint8_t *) data->seed);
 
@@ -269,6 +385,10 @@ void *benchmark_setup(const MunitParameter params[], MUNIT_UNUSED void *user_dat
 
 void benchmark_teardown(MUNIT_UNUSED void *user_data_or_fixture) {
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    free(data->cycles_start);
+    free(data->cycles_stop);
+    free(data->time_start);
+    free(data->time_stop);
     free(data);
 }
 
@@ -282,12 +402,29 @@ void get_clock(tspec_t *spec) {
     clock_gettime(CLOCK_PROCESS_CPUTIME_ID, spec);
 }
 
+void get_wall_clock(tspec_t *spec) {
+    clock_gettime(CLOCK_MONOTONIC, spec);
+}
+
+double elapsed_seconds(tspec_t *start, tspec_t *stop) {
+    tspec_t elapsed = timespec_sub(stop, start);
+    return timespec_to_double(&elapsed);
+}
+
 
 void report(const char *title, uint64_t *start_cycles, const uint64_t *stop_cycles, tspec_t *time_start,
             tspec_t *time_stop, size_t len) {
-    size_t i;
+    size_t i, warmup = (size_t) benchmark_warmup();
     tspec_t running_time = {.tv_sec = 0, .tv_nsec = 0};
     tspec_t aux;
+
+    if (warmup < len) {
+        start_cycles += warmup;
+        stop_cycles += warmup;
+        time_start += warmup;
+        time_stop += warmup;
+        len -= warmup;
+    }
     for (i = 0; i < len; i++) {
         start_cycles[i] = stop_cycles[i] - start_cycles[i];
         aux = timespec_sub(&time_stop[i], &time_start[i]);
@@ -301,8 +438,136 @@ void report(const char *title, uint64_t *start_cycles, const uint64_t *stop_cycl
     print_report(title, start_cycles, len, &running_time, time_start);
 }
 
+/*
+ * Hardware counters
+ */
+
+static const char *counter_names[BENCHMARK_COUNTERS] = {
+        "instructions", "cycles", "L1D read misses", "LLC read misses", "branch misses"
+};
+
+// A counter group only counts the thread that opened it, so each thread opens its own
+static _Thread_local struct {
+    int state;                                  // 0: not opened yet, 1: available, -1: unavailable
+    int leader;
+    int group_index[BENCHMARK_COUNTERS];        // position in the group read, -1 if the event did not open
+    int group_size;
+    char reason[64];
+} counters = {0};
+
+#ifdef __linux__
+static int counter_open(uint32_t type, uint64_t config, int group) {
+    struct perf_event_attr attribute;
+
+    memset(&attribute, 0, sizeof(attribute));
+    attribute.size = sizeof(attribute);
+    attribute.type = type;
+    attribute.config = config;
+    attribute.disabled = (group == -1);
+    attribute.exclude_kernel = 1;
+    attribute.exclude_hv = 1;
+    attribute.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int) syscall(SYS_perf_event_open, &attribute, 0, -1, group, 0);
+}
+
+static void counters_open(void) {
+    const uint32_t types[BENCHMARK_COUNTERS] = {
+            PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+    };
+    const uint64_t configs[BENCHMARK_COUNTERS] = {
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_BRANCH_MISSES
+    };
+    int fd, i;
+
+    counters.state = -1;
+    // Instructions lead the group: without them there is nothing worth reporting
+    counters.leader = counter_open(types[0], configs[0], -1);
+    if (counters.leader < 0) {
+        snprintf(counters.reason, sizeof(counters.reason), "perf_event_open: %s", strerror(errno));
+        return;
+    }
+    counters.group_index[0] = 0;
+    counters.group_size = 1;
+    // Events the PMU does not provide are left out of the group
+    for (i = 1; i < BENCHMARK_COUNTERS; i++) {
+        fd = counter_open(types[i], configs[i], counters.leader);
+        counters.group_index[i] = (fd < 0) ? -1 : counters.group_size++;
+    }
+    ioctl(counters.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    counters.state = 1;
+}
+#else
+static void counters_open(void) {
+    counters.state = -1;
+    snprintf(counters.reason, sizeof(counters.reason), "perf_event_open is Linux only");
+}
+#endif
+
+uint8_t counters_available(void) {
+    if (counters.state == 0) { counters_open(); }
+    return counters.state == 1;
+}
+
+void get_counters(benchmark_counters_t *output) {
+    uint64_t values[3 + BENCHMARK_COUNTERS] = {0};   // number of events, time enabled, time running, values
+    int i;
+
+    memset(output, 0, sizeof(benchmark_counters_t));
+    if (!counters_available()) { return; }
+    if (read(counters.leader, values, sizeof(values)) < (ssize_t) (3 * sizeof(uint64_t))) { return; }
+    for (i = 0; i < BENCHMARK_COUNTERS; i++) {
+        if (counters.group_index[i] < 0) { continue; }
+        output->value[i] = values[3 + counters.group_index[i]];
+        // Scaled up if the group was multiplexed with other users of the PMU
+        if (values[2] != 0 && values[2] < values[1]) {
+            output->value[i] = (uint64_t) ((double) output->value[i] * ((double) values[1] / (double) values[2]));
+        }
+    }
+}
+
+void counters_accumulate(benchmark_counters_t *total, const benchmark_counters_t *start,
+                         const benchmark_counters_t *stop) {
+    for (int i = 0; i < BENCHMARK_COUNTERS; i++) {
+        total->value[i] += stop->value[i] - start->value[i];
+    }
+}
+
+void report_counters(const char *title, const benchmark_counters_t *total, uint64_t operations) {
+    const uint64_t *value = total->value;
+
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %s counters over %" PRIu64 " operations",
+                  BENCHMARK_LEFT_PAD, title, operations);
+    if (!counters_available()) {
+        munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s unavailable (%s)", BENCHMARK_LEFT_PAD,
+                      counters.reason);
+        munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, " ");
+        return;
+    }
+    for (int i = 0; i < BENCHMARK_COUNTERS; i++) {
+        if (counters.group_index[i] < 0) {
+            munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s n/a\t\t %s", BENCHMARK_LEFT_PAD,
+                          counter_names[i]);
+        } else {
+            munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t %s [average]", BENCHMARK_LEFT_PAD,
+                          (double) value[i] / (double) operations, counter_names[i]);
+        }
+    }
+    if (counters.group_index[BENCHMARK_COUNTER_CYCLES] >= 0 && value[BENCHMARK_COUNTER_CYCLES] != 0) {
+        munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%-30s %lf\t\t IPC", BENCHMARK_LEFT_PAD,
+                      (double) value[BENCHMARK_COUNTER_INSTRUCTIONS] / (double) value[BENCHMARK_COUNTER_CYCLES]);
+    }
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, " ");
+}
+
 long get_iterations(const MunitParameter params[]) {
     const char *it = munit_parameters_get(params, ITERATIONS_PARAM);
+    if (benchmark_long_run() > 0) {
+        return benchmark_long_run();
+    }
     if (it == NULL) {
         return BENCHMARK_DEFAULT_ITERATIONS;
     }
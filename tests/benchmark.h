@@ -8,16 +8,56 @@
 #include "munit.h"
 
 #define KECCAK_SEED_LEN (size_t)(SECURITY_BITS / 8)
+#define BENCHMARK_LOG_LEVEL MUNIT_LOG_INFO
+#define BENCHMARK_LOG_FILE NULL
 extern MunitParameterEnum benchmark_iterations[];
 extern MunitParameterEnum benchmark_message_lengths[];
 
 typedef struct timespec tspec_t;
 
+// Hardware counters, in report_counters order
+#define BENCHMARK_COUNTERS              5
+#define BENCHMARK_COUNTER_INSTRUCTIONS  0
+#define BENCHMARK_COUNTER_CYCLES        1
+#define BENCHMARK_COUNTER_L1D_MISSES    2
+#define BENCHMARK_COUNTER_LLC_MISSES    3
+#define BENCHMARK_COUNTER_BRANCH_MISSES 4
+
+typedef struct {
+    uint64_t value[BENCHMARK_COUNTERS];
+} benchmark_counters_t;
+
+// Statistics of one report, as printed and as written by benchmark_record. The tail percentiles and the maximum
+// come from an HDR-style histogram of the samples
+#define BENCHMARK_Q1            0
+#define BENCHMARK_MEDIAN        1
+#define BENCHMARK_Q3            2
+#define BENCHMARK_AVERAGE       3
+#define BENCHMARK_P90           4
+#define BENCHMARK_P99           5
+#define BENCHMARK_P999          6
+#define BENCHMARK_MAX           7
+#define BENCHMARK_STATISTICS    8
+
+typedef struct {
+    char operation[128];
+    char prime[8];
+    char backend[8];
+    size_t iterations;
+    double seconds[BENCHMARK_STATISTICS];
+    uint64_t cycles[BENCHMARK_STATISTICS];
+} benchmark_summary_t;
+
 typedef struct {
     uint8_t seed[KECCAK_SEED_LEN];
     keccak_state shake_st;
     long iterations;
     long message_num_bytes;
+    // One sample per iteration, on the heap: long runs do not fit on the stack
+    uint64_t *cycles_start;
+    uint64_t *cycles_stop;
+    tspec_t *time_start;
+    tspec_t *time_stop;
 } benchmark_data_t;
 
 void *benchmark_setup(const MunitParameter params[], MUNIT_UNUSED void *user_data_or_fixture);
@@ -28,9 +68,52 @@ void get_cycles(uint64_t * result);
 
 void get_clock(struct timespec *spec);
 
+// Monotonic wall clock: unlike get_clock, it does not add up the time of concurrent threads
+void get_wall_clock(struct timespec *spec);
+
+double elapsed_seconds(tspec_t *start, tspec_t *stop);
+
+// The first benchmark_warmup() samples are warm-up iterations, and are left out of the report
 void report(const char *title, uint64_t *start_cycles, const uint64_t *stop_cycles, tspec_t *time_start,
             tspec_t *time_stop, size_t len);
 
+// Counters of the calling thread, through perf_event_open on Linux: each thread opens its own group on first use,
+// and threads started by the measured code are not counted. Without a PMU or the permission to use it
+// (kernel.perf_event_paranoid), they read as zeros and report_counters says so
+uint8_t counters_available(void);
+
+void get_counters(benchmark_counters_t *counters);
+
+// total += stop - start
+void counters_accumulate(benchmark_counters_t *total, const benchmark_counters_t *start,
+                         const benchmark_counters_t *stop);
+
+// Per-operation instructions, cycles, IPC, L1D and LLC read misses, and branch misses
+void report_counters(const char *title, const benchmark_counters_t *total, uint64_t operations);
+
+/*
+ * Machine-readable output and baseline comparison (benchmark_output.c)
+ */
+
+// --benchmark-output FILE, --benchmark-format csv|json, --benchmark-baseline FILE, --benchmark-threshold PERCENT,
+// --benchmark-warmup ITERATIONS, --benchmark-long-run SAMPLES
+extern const MunitArgument benchmark_arguments[];
+
+// Iterations benchmark_setup adds to every benchmark, to be dropped by report (0 by default)
+long benchmark_warmup(void);
+
+// Samples per report in long-run mode, overriding the iterations parameter (0 when off)
+long benchmark_long_run(void);
+
+// Operation, prime and backend of this build
+void benchmark_summary_init(benchmark_summary_t *summary, const char *operation, size_t iterations);
+
+// Appends the summary to the --benchmark-output file, if any; each record is a single write, so forked tests can share it
+void benchmark_record(const benchmark_summary_t *summary);
+
+// Compares the recorded summaries with the baseline, if any: the returned exit status is EXIT_FAILURE on regressions
+int benchmark_finish(int result);
+
 long get_iterations(const MunitParameter params[]);
 
 long get_message_num_bytes(const MunitParameter params[]);
@@ -0,0 +1,115 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "benchmark.h"
+#include <sidh.h>
+#include <signature.h>
+
+// Hardware counters per operation, to tell compute-bound code from memory-bound code
+#define COUNTERS_FIELD_MULTIPLICATIONS 1000
+
+static char *counters_signature_iterations[] = {"2", NULL};
+
+static MunitParameterEnum counters_signature_parameters[] = {
+        {"iterations", counters_signature_iterations},
+        PARAM_END
+};
+
+static MunitResult counters_field_multiplication(MUNIT_UNUSED const MunitParameter params[],
+                                                 void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    benchmark_counters_t start, stop, total = {0};
+    quadratic_field_element_t a, c;
+
+    quadratic_field_random(&a);
+    quadratic_field_random(&c);
+    for (long i = 0; i < data->iterations; i++) {
+        get_counters(&start);
+        for (unsigned j = 0; j < COUNTERS_FIELD_MULTIPLICATIONS; j++) {
+            quadratic_field_multiplication(&c, c, a);
+        }
+        get_counters(&stop);
+        counters_accumulate(&total, &start, &stop);
+        escape(&c);
+    }
+    report_counters("GF(p²) multiplication", &total, data->iterations * COUNTERS_FIELD_MULTIPLICATIONS);
+    return MUNIT_OK;
+}
+
+// Alice's secret kernel: the three-point ladder, then the 2ᵃ-isogeny walk pushing Bob's generators
+static MunitResult counters_ladder_and_isogeny(MUNIT_UNUSED const MunitParameter params[],
+                                               void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    benchmark_counters_t start, stop, total_ladder = {0}, total_isogeny = {0};
+    x_only_point_t P = {0}, Q = {0}, P_minus_Q = {0}, K;
+    quadratic_field_element_t A;
+    projective_curve_alice_t curve;
+    sidh_private_key_t private_key;
+
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(&A);
+    A.re[0] = 6;
+    quadratic_field_to_montgomery_representation(&A, A);
+    for (long i = 0; i < data->iterations; i++) {
+        sidh_generate_private_key_alice(&private_key, &data->shake_st);
+        initialize_generators_alice(&P.X, &Q.X, &P_minus_Q.X);
+        get_counters(&start);
+        x_only_three_point_ladder(&K, P.X, Q.X, P_minus_Q.X, private_key.key, SUBGROUP_ORDER_BITS_ALICE, A);
+        get_counters(&stop);
+        counters_accumulate(&total_ladder, &start, &stop);
+
+        initialize_generators_bob(&P.X, &Q.X, &P_minus_Q.X);
+        quadratic_field_set_to_one(&P.Z);
+        quadratic_field_set_to_one(&Q.Z);
+        quadratic_field_set_to_one(&P_minus_Q.Z);
+        to_projective_curve_alice(&curve, A);
+        get_counters(&start);
+        x_only_isogeny_from_kernel_alice(&P, &Q, &P_minus_Q, &curve, K);
+        get_counters(&stop);
+        counters_accumulate(&total_isogeny, &start, &stop);
+        escape(&P);
+    }
+    report_counters("Alice three-point ladder", &total_ladder, data->iterations);
+    report_counters("Alice isogeny walk", &total_isogeny, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult counters_sign_verify(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    benchmark_counters_t start, stop, total_sign = {0}, total_verify = {0};
+    uint8_t private_key[SECRET_KEY_BYTES];
+    uint8_t public_key[PUBLIC_KEY_BYTES];
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t message[data->message_num_bytes];
+    unsigned check = 0;
+
+    shake256(message, data->message_num_bytes, data->seed, KECCAK_SEED_LEN);
+    check |= sidh_signature_key_generation(private_key, public_key, &data->shake_st);
+    for (long i = 0; i < data->iterations; i++) {
+        get_counters(&start);
+        check |= sidh_signature_sign(signature, message, data->message_num_bytes, private_key, public_key,
+                                     &data->shake_st);
+        get_counters(&stop);
+        counters_accumulate(&total_sign, &start, &stop);
+
+        get_counters(&start);
+        check |= sidh_signature_verify(signature, message, data->message_num_bytes, public_key);
+        get_counters(&stop);
+        counters_accumulate(&total_verify, &start, &stop);
+    }
+    assert(check == EXIT_SUCCESS);
+    report_counters("SI-sign Sign", &total_sign, data->iterations);
+    report_counters("SI-sign Verify", &total_verify, data->iterations);
+    return MUNIT_OK;
+}
+
+/*
+ * Register benchmark cases
+ */
+
+// NOLINTNEXTLINE
+MunitTest benchmark_counters[] = {
+        BENCHMARK(counters_field_multiplication, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(counters_ladder_and_isogeny, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(counters_sign_verify, benchmark_setup, benchmark_teardown, counters_signature_parameters),
+        TEST_END
+};
@@ -0,0 +1,301 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "benchmark.h"
+#include <pok.h>
+#include <twisted_edwards.h>
+
+// Curve arithmetic in isolation, so a regression can be attributed to a layer below the protocol
+
+static void ecc_setup(quadratic_field_element_t *A,
+                      projective_curve_alice_t *curve_alice,
+                      projective_curve_bob_t *curve_bob) {
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(A);
+    A->re[0] = 6;
+    quadratic_field_to_montgomery_representation(A, *A);
+    to_projective_curve_alice(curve_alice, *A);
+    to_projective_curve_bob(curve_bob, *A);
+}
+
+static MunitResult ecc_point_doubling(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, Q, P_minus_Q;
+    projective_curve_alice_t curve_alice;
+    projective_curve_bob_t curve_bob;
+    x_only_point_t P = {0}, T;
+
+    ecc_setup(&A, &curve_alice, &curve_bob);
+    initialize_generators_alice(&P.X, &Q, &P_minus_Q);
+    quadratic_field_set_to_one(&P.Z);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_point_doubling(&T, P, curve_alice);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("ECC x-only point doubling", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult ecc_point_tripling(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, Q, P_minus_Q;
+    projective_curve_alice_t curve_alice;
+    projective_curve_bob_t curve_bob;
+    x_only_point_t P = {0}, T;
+
+    ecc_setup(&A, &curve_alice, &curve_bob);
+    initialize_generators_bob(&P.X, &Q, &P_minus_Q);
+    quadratic_field_set_to_one(&P.Z);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_point_tripling(&T, P, curve_bob);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("ECC x-only point tripling", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult ecc_three_point_ladder(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, P, Q, P_minus_Q;
+    projective_curve_alice_t curve_alice;
+    projective_curve_bob_t curve_bob;
+    sidh_private_key_t private_key;
+    x_only_point_t K;
+
+    ecc_setup(&A, &curve_alice, &curve_bob);
+    initialize_generators_alice(&P, &Q, &P_minus_Q);
+    for (i = 0; i < data->iterations; i++) {
+        sidh_generate_private_key_alice(&private_key, &data->shake_st);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_three_point_ladder(&K, P, Q, P_minus_Q, private_key.key, SUBGROUP_ORDER_BITS_ALICE, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&K);
+    }
+    report("ECC Alice three-point ladder", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+
+    initialize_generators_bob(&P, &Q, &P_minus_Q);
+    for (i = 0; i < data->iterations; i++) {
+        sidh_generate_private_key_bob(&private_key, &data->shake_st);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_three_point_ladder(&K, P, Q, P_minus_Q, private_key.key, SUBGROUP_ORDER_BITS_BOB, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&K);
+    }
+    report("ECC Bob three-point ladder", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult ecc_two_dimensional_scalar_multiplication(MUNIT_UNUSED const MunitParameter params[],
+                                                             void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, P, Q, P_minus_Q;
+    projective_curve_alice_t curve_alice;
+    projective_curve_bob_t curve_bob;
+    x_only_point_t T;
+    scalar_t c, d;
+
+    ecc_setup(&A, &curve_alice, &curve_bob);
+    initialize_generators_bob(&P, &Q, &P_minus_Q);
+    for (i = 0; i < data->iterations; i++) {
+        random_bob_scalar(c);
+        random_bob_scalar(d);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        two_dimensional_scalar_multiplication_bob(&T, P, Q, P_minus_Q, c, d, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("ECC Bob two-dimensional scalar multiplication", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult ecc_elligator2(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, u, r, r_squared;
+    projective_curve_alice_t curve_alice;
+    projective_curve_bob_t curve_bob;
+    x_only_point_t T;
+
+    ecc_setup(&A, &curve_alice, &curve_bob);
+    // u = (1 + i)², and r = j + i as in the canonical basis
+    quadratic_field_set_to_zero(&u);
+    prime_field_set_to_one(u.re);
+    prime_field_set_to_one(u.im);
+    quadratic_field_square(&u, u);
+    quadratic_field_set_to_zero(&r);
+    prime_field_set_to_one(r.im);
+    for (i = 0; i < data->iterations; i++) {
+        prime_field_addition(r.re, r.re, MONTGOMERY_CONSTANT_ONE);
+        quadratic_field_square(&r_squared, r);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_elligator2(&T, u, r_squared, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("ECC Elligator 2", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult ecc_canonical_basis(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, u;
+    sidh_private_key_t private_key;
+    sidh_public_key_t public_key;
+    x_only_point_t P, Q, P_minus_Q;
+    unsigned check = 0;
+
+    // u = 1 + i
+    quadratic_field_set_to_zero(&u);
+    prime_field_set_to_one(u.re);
+    prime_field_set_to_one(u.im);
+    for (i = 0; i < data->iterations; i++) {
+        // The curve of a fresh Alice public key, as in the signature
+        sidh_generate_private_key_alice(&private_key, &data->shake_st);
+        sidh_get_public_key_from_private_key_alice(&public_key, &private_key);
+        get_curve_from_points(&A, public_key.P, public_key.Q, public_key.P_minus_Q);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        check |= x_only_canonical_basis_bob(&P, &Q, &P_minus_Q, u, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&P);
+    }
+    assert(check == EXIT_SUCCESS);
+    report("ECC Bob canonical basis", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+// Affine Montgomery point (x, √(x³ + Ax² + x)) as a twisted Edwards point
+static void ecc_to_twisted_edwards(projective_point_t *output, quadratic_field_element_t x,
+                                   quadratic_field_element_t A) {
+    quadratic_field_element_t y, t;
+
+    quadratic_field_square(&t, x);
+    quadratic_field_multiplication(&y, A, t);
+    quadratic_field_addition(&y, y, x);
+    quadratic_field_multiplication(&t, t, x);
+    quadratic_field_addition(&y, y, t);
+    quadratic_field_is_square(&y, y);
+    to_twisted_edwards_model(output, x, y);
+}
+
+static MunitResult ecc_two_dimensional_pohlig_hellman(MUNIT_UNUSED const MunitParameter params[],
+                                                      void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, xP, xQ, xP_minus_Q;
+    projective_curve_alice_t curve_alice;
+    projective_curve_bob_t curve_bob;
+    twisted_edwards_curve_t curve;
+    projective_point_t P, Q, K;
+    x_only_point_t R;
+    scalar_t c, d, k;
+
+    ecc_setup(&A, &curve_alice, &curve_bob);
+    initialize_generators_bob(&xP, &xQ, &xP_minus_Q);
+    ecc_to_twisted_edwards(&P, xP, A);
+    ecc_to_twisted_edwards(&Q, xQ, A);
+    quadratic_field_copy(&curve.a, A);
+    prime_field_addition(curve.a.re, curve.a.re, MONTGOMERY_CONSTANT_ONE);
+    prime_field_addition(curve.a.re, curve.a.re, MONTGOMERY_CONSTANT_ONE);
+    quadratic_field_copy(&curve.d, A);
+    prime_field_subtraction(curve.d.re, curve.d.re, MONTGOMERY_CONSTANT_ONE);
+    prime_field_subtraction(curve.d.re, curve.d.re, MONTGOMERY_CONSTANT_ONE);
+
+    for (i = 0; i < data->iterations; i++) {
+        // ±(P + [k]Q): either sign lies on <P, Q>
+        random_bob_private_key(k);
+        x_only_three_point_ladder(&R, xP, xQ, xP_minus_Q, k, SUBGROUP_ORDER_BITS_BOB, A);
+        x_only_points_to_affine(&R, 1);
+        ecc_to_twisted_edwards(&K, R.X, A);
+
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        two_dimensional_pohlig_hellman_bob(c, d, K, P, Q, curve);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(c);
+    }
+    report("ECC Bob two-dimensional Pohlig-Hellman", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+/*
+ * Register benchmark cases
+ */
+
+// NOLINTNEXTLINE
+MunitTest benchmark_ecc[] = {
+        BENCHMARK(ecc_point_doubling, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(ecc_point_tripling, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(ecc_three_point_ladder, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(ecc_two_dimensional_scalar_multiplication, benchmark_setup, benchmark_teardown,
+                  benchmark_iterations),
+        BENCHMARK(ecc_elligator2, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(ecc_canonical_basis, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(ecc_two_dimensional_pohlig_hellman, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        TEST_END
+};
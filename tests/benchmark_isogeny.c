@@ -0,0 +1,194 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "benchmark.h"
+#include <sidh.h>
+
+// Isogeny kernels, evaluations and full strategy walks, starting at E₀ from a random kernel
+
+static void isogeny_setup_alice(x_only_point_t points[3],
+                                x_only_point_t *K,
+                                projective_curve_alice_t *curve,
+                                keccak_state *shake_st) {
+    quadratic_field_element_t A;
+    sidh_private_key_t private_key;
+    x_only_point_t P = {0}, Q = {0}, P_minus_Q = {0};
+
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(&A);
+    A.re[0] = 6;
+    quadratic_field_to_montgomery_representation(&A, A);
+    to_projective_curve_alice(curve, A);
+
+    initialize_generators_alice(&P.X, &Q.X, &P_minus_Q.X);
+    sidh_generate_private_key_alice(&private_key, shake_st);
+    x_only_three_point_ladder(K, P.X, Q.X, P_minus_Q.X, private_key.key, SUBGROUP_ORDER_BITS_ALICE, A);
+
+    // Bob's generators are the points pushed through Alice's isogeny
+    initialize_generators_bob(&points[0].X, &points[1].X, &points[2].X);
+    quadratic_field_set_to_one(&points[0].Z);
+    quadratic_field_set_to_one(&points[1].Z);
+    quadratic_field_set_to_one(&points[2].Z);
+}
+
+static void isogeny_setup_bob(x_only_point_t points[3],
+                              x_only_point_t *K,
+                              projective_curve_bob_t *curve,
+                              keccak_state *shake_st) {
+    quadratic_field_element_t A;
+    sidh_private_key_t private_key;
+    x_only_point_t P = {0}, Q = {0}, P_minus_Q = {0};
+
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(&A);
+    A.re[0] = 6;
+    quadratic_field_to_montgomery_representation(&A, A);
+    to_projective_curve_bob(curve, A);
+
+    initialize_generators_bob(&P.X, &Q.X, &P_minus_Q.X);
+    sidh_generate_private_key_bob(&private_key, shake_st);
+    x_only_three_point_ladder(K, P.X, Q.X, P_minus_Q.X, private_key.key, SUBGROUP_ORDER_BITS_BOB, A);
+
+    initialize_generators_alice(&points[0].X, &points[1].X, &points[2].X);
+    quadratic_field_set_to_one(&points[0].Z);
+    quadratic_field_set_to_one(&points[1].Z);
+    quadratic_field_set_to_one(&points[2].Z);
+}
+
+static MunitResult isogeny_4_isogeny(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t isogeny_coefficients[3];
+    projective_curve_alice_t curve, image_curve;
+    x_only_point_t points[3], K, T;
+
+    isogeny_setup_alice(points, &K, &curve, &data->shake_st);
+    x_only_multiple_point_doublings(&K, K, EXPONENT_ALICE - 2, curve);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_4_isogeny(&image_curve, isogeny_coefficients, K);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&image_curve);
+    }
+    report("Isogeny 4-isogeny kernel", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_4_isogeny_evaluation(&T, points[0], isogeny_coefficients);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("Isogeny 4-isogeny evaluation", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult isogeny_3_isogeny(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t isogeny_coefficients[2];
+    projective_curve_bob_t curve, image_curve;
+    x_only_point_t points[3], K, T;
+
+    isogeny_setup_bob(points, &K, &curve, &data->shake_st);
+    x_only_multiple_point_triplings(&K, K, EXPONENT_BOB - 1, curve);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_3_isogeny(&image_curve, isogeny_coefficients, K);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&image_curve);
+    }
+    report("Isogeny 3-isogeny kernel", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_3_isogeny_evaluation(&T, points[0], isogeny_coefficients);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("Isogeny 3-isogeny evaluation", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult isogeny_walk_alice(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    projective_curve_alice_t curve;
+    x_only_point_t points[3], K;
+
+    for (i = 0; i < data->iterations; i++) {
+        isogeny_setup_alice(points, &K, &curve, &data->shake_st);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_isogeny_from_kernel_alice(&points[0], &points[1], &points[2], &curve, K);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(points);
+    }
+    report("Isogeny Alice 2ᵃ-isogeny walk", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult isogeny_walk_bob(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    projective_curve_bob_t curve;
+    x_only_point_t points[3], K;
+
+    for (i = 0; i < data->iterations; i++) {
+        isogeny_setup_bob(points, &K, &curve, &data->shake_st);
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_isogeny_from_kernel_bob(&points[0], &points[1], &points[2], &curve, K);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(points);
+    }
+    report("Isogeny Bob 3ᵇ-isogeny walk", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+/*
+ * Register benchmark cases
+ */
+
+// NOLINTNEXTLINE
+MunitTest benchmark_isogeny[] = {
+        BENCHMARK(isogeny_4_isogeny, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(isogeny_3_isogeny, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(isogeny_walk_alice, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(isogeny_walk_bob, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        TEST_END
+};
@@ -0,0 +1,329 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "benchmark.h"
+#include <pok.h>
+#include <signature.h>
+
+// Peak stack depth and heap use per operation, to size thread stacks. Each operation runs on a thread whose stack
+// is painted beforehand and sits above a guard page; the deepest overwritten byte gives the high-water mark
+#define MEMORY_STACK_BYTES  (4 << 20)
+#define MEMORY_PAINT        0xA5
+#define MEMORY_BATCH_KEYS   4
+
+// The heap is tracked by replacing malloc and its siblings (glibc lets a program do so), while a measured operation
+// runs. Stacks of the threads an operation starts are mapped by the C library, and not counted
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#define MEMORY_HEAP_TRACKING
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t number, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *pointer);
+extern size_t malloc_usable_size(void *pointer);
+
+// Blocks allocated before tracking started may be freed while it runs: the current use can go negative
+static struct {
+    int enabled;
+    int64_t current;
+    int64_t peak;
+    size_t allocations;
+} heap = {0};
+
+static void heap_allocated(void *pointer) {
+    int64_t current, peak;
+    if (pointer == NULL || !__atomic_load_n(&heap.enabled, __ATOMIC_RELAXED)) { return; }
+    current = __atomic_add_fetch(&heap.current, (int64_t) malloc_usable_size(pointer), __ATOMIC_RELAXED);
+    __atomic_add_fetch(&heap.allocations, 1, __ATOMIC_RELAXED);
+    peak = __atomic_load_n(&heap.peak, __ATOMIC_RELAXED);
+    while (current > peak &&
+           !__atomic_compare_exchange_n(&heap.peak, &peak, current, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+}
+
+static void heap_released(void *pointer) {
+    if (pointer == NULL || !__atomic_load_n(&heap.enabled, __ATOMIC_RELAXED)) { return; }
+    __atomic_sub_fetch(&heap.current, (int64_t) malloc_usable_size(pointer), __ATOMIC_RELAXED);
+}
+
+void *malloc(size_t size) {
+    void *pointer = __libc_malloc(size);
+    heap_allocated(pointer);
+    return pointer;
+}
+
+void *calloc(size_t number, size_t size) {
+    void *pointer = __libc_calloc(number, size);
+    heap_allocated(pointer);
+    return pointer;
+}
+
+void *realloc(void *pointer, size_t size) {
+    heap_released(pointer);
+    pointer = __libc_realloc(pointer, size);
+    heap_allocated(pointer);
+    return pointer;
+}
+
+// Aligned blocks are released through free as well, so they must be counted when allocated
+void *aligned_alloc(size_t alignment, size_t size) {
+    void *pointer = __libc_memalign(alignment, size);
+    heap_allocated(pointer);
+    return pointer;
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) {
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) { return EINVAL; }
+    *pointer = __libc_memalign(alignment, size);
+    if (*pointer == NULL) { return ENOMEM; }
+    heap_allocated(*pointer);
+    return 0;
+}
+
+void free(void *pointer) {
+    heap_released(pointer);
+    __libc_free(pointer);
+}
+
+static void heap_tracking(int enabled) {
+    if (enabled) {
+        heap.current = 0;
+        heap.peak = 0;
+        heap.allocations = 0;
+    }
+    __atomic_store_n(&heap.enabled, enabled, __ATOMIC_SEQ_CST);
+}
+#endif
+
+typedef struct {
+    void (*operation)(void *argument);
+    void *argument;
+} memory_task_t;
+
+typedef struct {
+    size_t stack;
+    size_t heap_peak;
+    size_t heap_allocations;
+} memory_usage_t;
+
+static void *memory_thread(void *argument) {
+    memory_task_t *task = (memory_task_t *) argument;
+#ifdef MEMORY_HEAP_TRACKING
+    heap_tracking(1);
+    task->operation(task->argument);
+    heap_tracking(0);
+#else
+    task->operation(task->argument);
+#endif
+    return NULL;
+}
+
+static void memory_nothing(MUNIT_UNUSED void *argument) {}
+
+static void memory_run(memory_usage_t *usage, void (*operation)(void *), void *argument) {
+    size_t page = (size_t) sysconf(_SC_PAGESIZE), i;
+    memory_task_t task = {operation, argument};
+    pthread_attr_t attributes;
+    pthread_t thread;
+    uint8_t *map, *stack;
+
+    map = mmap(NULL, MEMORY_STACK_BYTES + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK,
+               -1, 0);
+    munit_assert_ptr_not_equal(map, MAP_FAILED);
+    // Stacks grow down: an overflow faults on the guard page instead of going unnoticed
+    munit_assert_int(mprotect(map, page, PROT_NONE), ==, 0);
+    stack = &map[page];
+    memset(stack, MEMORY_PAINT, MEMORY_STACK_BYTES);
+
+    pthread_attr_init(&attributes);
+    pthread_attr_setstack(&attributes, stack, MEMORY_STACK_BYTES);
+    munit_assert_int(pthread_create(&thread, &attributes, memory_thread, &task), ==, 0);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attributes);
+
+    for (i = 0; i < MEMORY_STACK_BYTES && stack[i] == MEMORY_PAINT; i++) {}
+    usage->stack = MEMORY_STACK_BYTES - i;
+#ifdef MEMORY_HEAP_TRACKING
+    usage->heap_peak = (size_t) heap.peak;
+    usage->heap_allocations = heap.allocations;
+#else
+    usage->heap_peak = 0;
+    usage->heap_allocations = 0;
+#endif
+    munmap(map, MEMORY_STACK_BYTES + page);
+}
+
+// Largest usage over the iterations, net of the thread start-up (descriptor and TLS at the top of the stack)
+static void memory_report(const char *title, void (*operation)(void *), void *argument, long iterations,
+                          size_t workspace_bytes) {
+    memory_usage_t baseline, usage, peak = {0};
+    benchmark_summary_t summary;
+
+    memory_run(&baseline, memory_nothing, NULL);
+    for (long i = 0; i < iterations; i++) {
+        memory_run(&usage, operation, argument);
+        peak.stack = (usage.stack > peak.stack) ? usage.stack : peak.stack;
+        peak.heap_peak = (usage.heap_peak > peak.heap_peak) ? usage.heap_peak : peak.heap_peak;
+        peak.heap_allocations = (usage.heap_allocations > peak.heap_allocations) ? usage.heap_allocations
+                                                                                : peak.heap_allocations;
+    }
+
+    benchmark_summary_init(&summary, title, (size_t) iterations);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%s %s memory over %ld iterations", title,
+                  summary.prime, iterations);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%zu\t\t bytes of stack [high-water]",
+                  peak.stack - baseline.stack);
+#ifdef MEMORY_HEAP_TRACKING
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%zu\t\t bytes of heap [peak]", peak.heap_peak);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%zu\t\t heap allocations", peak.heap_allocations);
+#else
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "n/a\t\t bytes of heap (needs glibc)");
+#endif
+    if (workspace_bytes > 0) {
+        munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%zu\t\t bytes of caller workspace",
+                      workspace_bytes);
+    }
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, " ");
+}
+
+/*
+ * Operations
+ */
+
+typedef struct {
+    keccak_state *shake_st;
+    uint8_t private_key[SECRET_KEY_BYTES];
+    uint8_t public_key[PUBLIC_KEY_BYTES];
+    uint8_t signature[SIGNATURE_BYTES];
+    uint8_t message[64];
+    uint8_t batch_private_keys[MEMORY_BATCH_KEYS * SECRET_KEY_BYTES];
+    uint8_t batch_public_keys[MEMORY_BATCH_KEYS * PUBLIC_KEY_BYTES];
+    void *workspace;
+    unsigned check;
+} memory_signature_t;
+
+static void memory_key_generation(void *argument) {
+    memory_signature_t *keys = (memory_signature_t *) argument;
+    keys->check |= sidh_signature_key_generation(keys->private_key, keys->public_key, keys->shake_st);
+}
+
+// Single-threaded: the tables of the batch are on the heap
+static void memory_key_generation_batch(void *argument) {
+    memory_signature_t *keys = (memory_signature_t *) argument;
+    keys->check |= sidh_signature_key_generation_batch(keys->batch_private_keys, keys->batch_public_keys,
+                                                       MEMORY_BATCH_KEYS, keys->shake_st, 1);
+}
+
+static void memory_sign(void *argument) {
+    memory_signature_t *keys = (memory_signature_t *) argument;
+    keys->check |= sidh_signature_sign(keys->signature, keys->message, sizeof(keys->message), keys->private_key,
+                                       keys->public_key, keys->shake_st);
+}
+
+static void memory_sign_workspace(void *argument) {
+    memory_signature_t *keys = (memory_signature_t *) argument;
+    keys->check |= sidh_signature_sign_workspace(keys->signature, keys->message, sizeof(keys->message),
+                                                 keys->private_key, keys->public_key, keys->shake_st,
+                                                 keys->workspace, sidh_signature_workspace_bytes());
+}
+
+static void memory_verify(void *argument) {
+    memory_signature_t *keys = (memory_signature_t *) argument;
+    keys->check |= sidh_signature_verify(keys->signature, keys->message, sizeof(keys->message), keys->public_key);
+}
+
+static MunitResult memory_signature(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    memory_signature_t *keys = munit_malloc(sizeof(memory_signature_t));
+
+    keys->shake_st = &data->shake_st;
+    keys->check = 0;
+    shake256(keys->message, sizeof(keys->message), data->seed, KECCAK_SEED_LEN);
+    keys->workspace = aligned_alloc(SIGNATURE_WORKSPACE_ALIGNMENT, SIGNATURE_WORKSPACE_BYTES);
+    munit_assert_not_null(keys->workspace);
+
+    memory_report("SI-sign KeyGen", memory_key_generation, keys, data->iterations, 0);
+    memory_report("SI-sign KeyGen batch of 4", memory_key_generation_batch, keys, data->iterations, 0);
+    memory_report("SI-sign Sign", memory_sign, keys, data->iterations, 0);
+    memory_report("SI-sign Sign (caller workspace)", memory_sign_workspace, keys, data->iterations,
+                  sidh_signature_workspace_bytes());
+    memory_report("SI-sign Verify", memory_verify, keys, data->iterations, 0);
+    assert(keys->check == EXIT_SUCCESS);
+
+    free(keys->workspace);
+    free(keys);
+    return MUNIT_OK;
+}
+
+typedef struct {
+    keccak_state *shake_st;
+    quadratic_field_element_t A;
+    sidh_public_key_t basis;
+    unsigned check;
+} memory_curve_t;
+
+static void memory_isogeny_walk_alice(void *argument) {
+    memory_curve_t *curve = (memory_curve_t *) argument;
+    sidh_private_key_t private_key;
+    sidh_public_key_t public_key;
+
+    sidh_generate_private_key_alice(&private_key, curve->shake_st);
+    sidh_get_public_key_from_private_key_alice(&public_key, &private_key);
+}
+
+static void memory_isogeny_walk_bob(void *argument) {
+    memory_curve_t *curve = (memory_curve_t *) argument;
+    sidh_private_key_t private_key;
+    sidh_public_key_t public_key;
+
+    sidh_generate_private_key_bob(&private_key, curve->shake_st);
+    sidh_get_public_key_from_private_key_bob(&public_key, &private_key);
+}
+
+// The kernel of a random Bob isogeny, written on the generators of E₀[3ᵇ]
+static void memory_pohlig_hellman(void *argument) {
+    memory_curve_t *curve = (memory_curve_t *) argument;
+    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS];
+    x_only_point_t K;
+    scalar_t k, c, d;
+
+    random_bob_private_key(k);
+    x_only_three_point_ladder(&K, curve->basis.P, curve->basis.Q, curve->basis.P_minus_Q, k,
+                              SUBGROUP_ORDER_BITS_BOB, curve->A);
+    x_only_points_to_affine(&K, 1);
+    curve->check |= decomposition_by_scalars(c, d, K.X, curve->basis, curve->A, workspace);
+}
+
+static MunitResult memory_curves(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    memory_curve_t curve;
+
+    curve.shake_st = &data->shake_st;
+    curve.check = 0;
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(&curve.A);
+    curve.A.re[0] = 6;
+    quadratic_field_to_montgomery_representation(&curve.A, curve.A);
+    initialize_generators_bob(&curve.basis.P, &curve.basis.Q, &curve.basis.P_minus_Q);
+
+    memory_report("SIDH Alice public key (2ᵃ-isogeny walk)", memory_isogeny_walk_alice, &curve, data->iterations, 0);
+    memory_report("SIDH Bob public key (3ᵇ-isogeny walk)", memory_isogeny_walk_bob, &curve, data->iterations, 0);
+    memory_report("PoK two-dimensional Pohlig-Hellman", memory_pohlig_hellman, &curve, data->iterations, 0);
+    assert(curve.check == EXIT_SUCCESS);
+    return MUNIT_OK;
+}
+
+/*
+ * Register benchmark cases
+ */
+
+// NOLINTNEXTLINE
+MunitTest benchmark_memory[] = {
+        BENCHMARK(memory_signature, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(memory_curves, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        TEST_END
+};
@@ -0,0 +1,323 @@
+//
+// Machine-readable benchmark output, and comparison against a stored baseline
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/stat.h>
+#include "benchmark.h"
+
+#define BENCHMARK_FORMAT_CSV        0
+#define BENCHMARK_FORMAT_JSON       1       // JSON Lines: one object per line, as records are appended by each test
+#define BENCHMARK_DEFAULT_THRESHOLD 5.0     // percent of the baseline median
+#define BENCHMARK_RECORD_BYTES      1024
+#define BENCHMARK_MAX_SAMPLES       100000  // per option, as samples and warm-up iterations are both stored
+
+#define BENCHMARK_CSV_HEADER "operation,prime,backend,iterations," \
+                             "seconds_q1,seconds_median,seconds_q3,seconds_average," \
+                             "seconds_p90,seconds_p99,seconds_p999,seconds_max," \
+                             "cycles_q1,cycles_median,cycles_q3,cycles_average," \
+                             "cycles_p90,cycles_p99,cycles_p999,cycles_max\n"
+#define BENCHMARK_CSV_RECORD "\"%127[^\"]\",%7[^,],%7[^,],%zu,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf," \
+                             "%" SCNu64 ",%" SCNu64 ",%" SCNu64 ",%" SCNu64 ",%" SCNu64 ",%" SCNu64 ",%" SCNu64 ",%" SCNu64
+#define BENCHMARK_JSON_RECORD "{\"operation\":\"%127[^\"]\",\"prime\":\"%7[^\"]\",\"backend\":\"%7[^\"]\"," \
+                              "\"iterations\":%zu,\"seconds\":{\"q1\":%lf,\"median\":%lf,\"q3\":%lf,\"average\":%lf," \
+                              "\"p90\":%lf,\"p99\":%lf,\"p99.9\":%lf,\"max\":%lf}," \
+                              "\"cycles\":{\"q1\":%" SCNu64 ",\"median\":%" SCNu64 ",\"q3\":%" SCNu64 ",\"average\":%" SCNu64 \
+                              ",\"p90\":%" SCNu64 ",\"p99\":%" SCNu64 ",\"p99.9\":%" SCNu64 ",\"max\":%" SCNu64 "}}"
+
+static struct {
+    char *output;
+    char *baseline;
+    int format;
+    double threshold;
+    uint8_t temporary_output;       // created for --benchmark-baseline alone, removed by benchmark_finish
+    long warmup;
+    long long_run;
+} benchmark_options = {NULL, NULL, BENCHMARK_FORMAT_CSV, BENCHMARK_DEFAULT_THRESHOLD, 0, 0, 0};
+
+long benchmark_warmup(void) {
+    return benchmark_options.warmup;
+}
+
+long benchmark_long_run(void) {
+    return benchmark_options.long_run;
+}
+
+void benchmark_summary_init(benchmark_summary_t *summary, const char *operation, size_t iterations) {
+#if defined(_P377_)
+    char *prime = "p377";
+#elif defined(_P434_)
+    char * prime = "p434";
+#elif defined(_P503_)
+    char * prime = "p503";
+#elif defined(_P546_)
+    char * prime = "p546";
+#elif defined(_P610_)
+    char * prime = "p610";
+#elif defined(_P697_)
+    char * prime = "p697";
+#elif defined(_P751_)
+    char * prime = "p751";
+#else
+    char * prime = "p434";
+#endif
+#if defined(QUADRATIC_FIELD_ASM)
+    char *backend = "asm";
+#else
+    char *backend = "c";
+#endif
+
+    memset(summary, 0, sizeof(benchmark_summary_t));
+    // Quotes would end the operation field in both formats
+    for (size_t i = 0; operation[i] != '\0' && i < sizeof(summary->operation) - 1; i++) {
+        summary->operation[i] = (operation[i] == '"') ? '\'' : operation[i];
+    }
+    snprintf(summary->prime, sizeof(summary->prime), "%s", prime);
+    snprintf(summary->backend, sizeof(summary->backend), "%s", backend);
+    summary->iterations = iterations;
+}
+
+void benchmark_record(const benchmark_summary_t *summary) {
+    char record[sizeof(BENCHMARK_CSV_HEADER) + BENCHMARK_RECORD_BYTES];
+    const double *seconds = summary->seconds;
+    const uint64_t *cycles = summary->cycles;
+    struct stat status;
+    int length = 0, fd;
+
+    if (benchmark_options.output == NULL) { return; }
+    fd = open(benchmark_options.output, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) { return; }
+
+    if (benchmark_options.format == BENCHMARK_FORMAT_JSON) {
+        length = snprintf(record, sizeof(record),
+                          "{\"operation\":\"%s\",\"prime\":\"%s\",\"backend\":\"%s\",\"iterations\":%zu,"
+                          "\"seconds\":{\"q1\":%.9lf,\"median\":%.9lf,\"q3\":%.9lf,\"average\":%.9lf,"
+                          "\"p90\":%.9lf,\"p99\":%.9lf,\"p99.9\":%.9lf,\"max\":%.9lf},"
+                          "\"cycles\":{\"q1\":%" PRIu64 ",\"median\":%" PRIu64 ",\"q3\":%" PRIu64
+                          ",\"average\":%" PRIu64 ",\"p90\":%" PRIu64 ",\"p99\":%" PRIu64 ",\"p99.9\":%" PRIu64
+                          ",\"max\":%" PRIu64 "}}\n",
+                          summary->operation, summary->prime, summary->backend, summary->iterations,
+                          seconds[0], seconds[1], seconds[2], seconds[3], seconds[4], seconds[5], seconds[6], seconds[7],
+                          cycles[0], cycles[1], cycles[2], cycles[3], cycles[4], cycles[5], cycles[6], cycles[7]);
+    } else {
+        // Tests run one after the other, so only the first record sees an empty file
+        if (fstat(fd, &status) == 0 && status.st_size == 0) {
+            length = snprintf(record, sizeof(record), "%s", BENCHMARK_CSV_HEADER);
+        }
+        length += snprintf(&record[length], sizeof(record) - length,
+                           "\"%s\",%s,%s,%zu,%.9lf,%.9lf,%.9lf,%.9lf,%.9lf,%.9lf,%.9lf,%.9lf,"
+                           "%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                           summary->operation, summary->prime, summary->backend, summary->iterations,
+                           seconds[0], seconds[1], seconds[2], seconds[3], seconds[4], seconds[5], seconds[6], seconds[7],
+                           cycles[0], cycles[1], cycles[2], cycles[3], cycles[4], cycles[5], cycles[6], cycles[7]);
+    }
+    if (length > 0 && (size_t) length < sizeof(record) && write(fd, record, length) != length) {
+        fprintf(stderr, "benchmark: short write to %s\n", benchmark_options.output);
+    }
+    close(fd);
+}
+
+// Either format, whatever --benchmark-format says: CSV headers and unparsable lines are skipped
+static benchmark_summary_t *benchmark_load(const char *path, size_t *number_of_summaries) {
+    benchmark_summary_t *summaries = NULL, *grown, summary;
+    size_t capacity = 0;
+    char line[BENCHMARK_RECORD_BYTES];
+    const char *format;
+    FILE *file;
+
+    *number_of_summaries = 0;
+    file = fopen(path, "r");
+    if (file == NULL) { return NULL; }
+    while (fgets(line, sizeof(line), file) != NULL) {
+        memset(&summary, 0, sizeof(summary));
+        format = (line[0] == '{') ? BENCHMARK_JSON_RECORD : BENCHMARK_CSV_RECORD;
+        if (sscanf(line, format, summary.operation, summary.prime, summary.backend, &summary.iterations,
+                   &summary.seconds[0], &summary.seconds[1], &summary.seconds[2], &summary.seconds[3],
+                   &summary.seconds[4], &summary.seconds[5], &summary.seconds[6], &summary.seconds[7],
+                   &summary.cycles[0], &summary.cycles[1], &summary.cycles[2], &summary.cycles[3],
+                   &summary.cycles[4], &summary.cycles[5], &summary.cycles[6], &summary.cycles[7]) != 20) {
+            continue;
+        }
+        if (*number_of_summaries == capacity) {
+            capacity = (capacity == 0) ? 64 : 2 * capacity;
+            grown = realloc(summaries, capacity * sizeof(benchmark_summary_t));
+            if (grown == NULL) { break; }
+            summaries = grown;
+        }
+        summaries[(*number_of_summaries)++] = summary;
+    }
+    fclose(file);
+    // An empty baseline is still a baseline
+    return (summaries != NULL) ? summaries : calloc(1, sizeof(benchmark_summary_t));
+}
+
+// A regression is a median slower than the threshold allows, whose interquartile range also lies above the
+// baseline's: the first quartile is past the baseline third quartile. Reports with fewer than four iterations
+// have no quartiles, and are judged on the median alone
+static unsigned benchmark_compare(const benchmark_summary_t *results, size_t number_of_results,
+                                  const benchmark_summary_t *baseline, size_t baseline_size) {
+    const benchmark_summary_t *reference;
+    unsigned regressions = 0, missing = 0;
+    uint8_t separated, regression;
+    double change;
+
+    printf("\nBaseline comparison against %s (threshold %.2lf%% of the median cycles)\n",
+           benchmark_options.baseline, benchmark_options.threshold);
+    for (size_t i = 0; i < number_of_results; i++) {
+        reference = NULL;
+        for (size_t j = 0; j < baseline_size; j++) {
+            if (strcmp(results[i].operation, baseline[j].operation) == 0 &&
+                strcmp(results[i].prime, baseline[j].prime) == 0 &&
+                strcmp(results[i].backend, baseline[j].backend) == 0) {
+                reference = &baseline[j];
+            }
+        }
+        if (reference == NULL || reference->cycles[BENCHMARK_MEDIAN] == 0) {
+            missing++;
+            continue;
+        }
+
+        change = 100.0 * ((double) results[i].cycles[BENCHMARK_MEDIAN] -
+                          (double) reference->cycles[BENCHMARK_MEDIAN]) / (double) reference->cycles[BENCHMARK_MEDIAN];
+        separated = (results[i].cycles[BENCHMARK_Q1] == 0 || reference->cycles[BENCHMARK_Q3] == 0) ||
+                    (results[i].cycles[BENCHMARK_Q1] > reference->cycles[BENCHMARK_Q3]);
+        regression = (change > benchmark_options.threshold) && separated;
+        regressions += regression;
+        printf("%-12s %-48s %s %-3s %" PRIu64 " -> %" PRIu64 " cycles (%+.2lf%%)\n",
+               regression ? "REGRESSION" : "ok", results[i].operation, results[i].prime, results[i].backend,
+               reference->cycles[BENCHMARK_MEDIAN], results[i].cycles[BENCHMARK_MEDIAN], change);
+    }
+    printf("%zu compared, %u without a baseline, %u regressions\n", number_of_results - missing, missing, regressions);
+    return regressions;
+}
+
+int benchmark_finish(int result) {
+    benchmark_summary_t *results, *baseline;
+    size_t number_of_results, baseline_size;
+
+    if (benchmark_options.baseline != NULL) {
+        baseline = benchmark_load(benchmark_options.baseline, &baseline_size);
+        results = benchmark_load(benchmark_options.output, &number_of_results);
+        if (baseline == NULL) {
+            fprintf(stderr, "benchmark: cannot read the baseline %s\n", benchmark_options.baseline);
+            result = EXIT_FAILURE;
+        } else if (results != NULL && benchmark_compare(results, number_of_results, baseline, baseline_size) > 0) {
+            result = EXIT_FAILURE;
+        }
+        free(results);
+        free(baseline);
+    }
+    if (benchmark_options.temporary_output) { unlink(benchmark_options.output); }
+    free(benchmark_options.output);
+    free(benchmark_options.baseline);
+    return result;
+}
+
+/*
+ * Command line arguments
+ */
+
+static munit_bool benchmark_parse_argument(MUNIT_UNUSED const MunitSuite *suite, MUNIT_UNUSED void *user_data,
+                                           int *arg, int argc, char *const argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    const char *name = argv[*arg] + 2, *value;
+    char *end, temporary[] = "/tmp/sidh-benchmark-XXXXXX";
+    FILE *file;
+    int fd;
+
+    if (*arg + 1 >= argc) {
+        fprintf(stderr, "--%s requires a value\n", name);
+        return 0;
+    }
+    value = argv[++(*arg)];
+
+    if (strcmp(name, "benchmark-output") == 0) {
+        if (benchmark_options.temporary_output) { unlink(benchmark_options.output); }
+        free(benchmark_options.output);
+        benchmark_options.output = strdup(value);
+        benchmark_options.temporary_output = 0;
+        // Records are appended by each test, so start from an empty file
+        file = fopen(value, "w");
+        if (file == NULL) {
+            fprintf(stderr, "--benchmark-output: cannot create %s\n", value);
+            return 0;
+        }
+        fclose(file);
+    } else if (strcmp(name, "benchmark-format") == 0) {
+        if (strcmp(value, "csv") == 0) {
+            benchmark_options.format = BENCHMARK_FORMAT_CSV;
+        } else if (strcmp(value, "json") == 0) {
+            benchmark_options.format = BENCHMARK_FORMAT_JSON;
+        } else {
+            fprintf(stderr, "--benchmark-format: expected csv or json, got %s\n", value);
+            return 0;
+        }
+    } else if (strcmp(name, "benchmark-baseline") == 0) {
+        free(benchmark_options.baseline);
+        benchmark_options.baseline = strdup(value);
+        if (benchmark_options.output == NULL) {
+            fd = mkstemp(temporary);
+            if (fd < 0) { return 0; }
+            close(fd);
+            benchmark_options.output = strdup(temporary);
+            benchmark_options.temporary_output = 1;
+        }
+    } else if (strcmp(name, "benchmark-warmup") == 0) {
+        benchmark_options.warmup = strtol(value, &end, 10);
+        if (*end != '\0' || benchmark_options.warmup < 0 || benchmark_options.warmup > BENCHMARK_MAX_SAMPLES) {
+            fprintf(stderr, "--benchmark-warmup: expected 0 to %d iterations, got %s\n", BENCHMARK_MAX_SAMPLES, value);
+            return 0;
+        }
+    } else if (strcmp(name, "benchmark-long-run") == 0) {
+        benchmark_options.long_run = strtol(value, &end, 10);
+        if (*end != '\0' || benchmark_options.long_run < 0 || benchmark_options.long_run > BENCHMARK_MAX_SAMPLES) {
+            fprintf(stderr, "--benchmark-long-run: expected 0 to %d samples, got %s\n", BENCHMARK_MAX_SAMPLES, value);
+            return 0;
+        }
+    } else {
+        benchmark_options.threshold = strtod(value, &end);
+        if (*end != '\0' || benchmark_options.threshold < 0) {
+            fprintf(stderr, "--benchmark-threshold: expected a non-negative percentage, got %s\n", value);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void benchmark_write_help(const MunitArgument *argument, MUNIT_UNUSED void *user_data) {
+    if (strcmp(argument->name, "benchmark-output") == 0) {
+        puts(" --benchmark-output FILE\n"
+             "           Write every benchmark report to FILE, one record per line.");
+    } else if (strcmp(argument->name, "benchmark-format") == 0) {
+        puts(" --benchmark-format csv|json\n"
+             "           Format of --benchmark-output: CSV with a header (default), or JSON Lines.");
+    } else if (strcmp(argument->name, "benchmark-baseline") == 0) {
+        puts(" --benchmark-baseline FILE\n"
+             "           Compare the reports with FILE, a previous --benchmark-output in either format,\n"
+             "           and exit with a failure on regressions.");
+    } else if (strcmp(argument->name, "benchmark-warmup") == 0) {
+        puts(" --benchmark-warmup ITERATIONS\n"
+             "           Run ITERATIONS more iterations of every benchmark, left out of its reports.");
+    } else if (strcmp(argument->name, "benchmark-long-run") == 0) {
+        puts(" --benchmark-long-run SAMPLES\n"
+             "           Take SAMPLES samples per report, whatever the iterations parameter, and report\n"
+             "           the latency distribution on top of the tail percentiles.");
+    } else {
+        puts(" --benchmark-threshold PERCENT\n"
+             "           Median cycle increase tolerated by --benchmark-baseline (default 5).");
+    }
+}
+
+const MunitArgument benchmark_arguments[] = {
+        {"benchmark-output", benchmark_parse_argument, benchmark_write_help},
+        {"benchmark-format", benchmark_parse_argument, benchmark_write_help},
+        {"benchmark-baseline", benchmark_parse_argument, benchmark_write_help},
+        {"benchmark-threshold", benchmark_parse_argument, benchmark_write_help},
+        {"benchmark-warmup", benchmark_parse_argument, benchmark_write_help},
+        {"benchmark-long-run", benchmark_parse_argument, benchmark_write_help},
+        {NULL, NULL, NULL}
+};
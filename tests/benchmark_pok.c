@@ -62,10 +62,10 @@ static void canonical_basis_naive(sidh_public_key_t *output_basis, quadratic_fie
 static MunitResult test_canonical_basis(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
     unsigned i;
-    uint64_t cycles_start[data->iterations];
-    uint64_t cycles_stop[data->iterations];
-    tspec_t time_start[data->iterations];
-    tspec_t time_stop[data->iterations];
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
 
     quadratic_field_element_t A;
     sidh_private_key_t sk_alice;
@@ -90,10 +90,10 @@ static MunitResult test_canonical_basis(MUNIT_UNUSED const MunitParameter params
 static MunitResult test_canonical_basis_naive(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
     unsigned i;
-    uint64_t cycles_start[data->iterations];
-    uint64_t cycles_stop[data->iterations];
-    tspec_t time_start[data->iterations];
-    tspec_t time_stop[data->iterations];
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
 
     quadratic_field_element_t A;
     sidh_private_key_t sk_alice;
@@ -119,10 +119,10 @@ static MunitResult test_two_dimensional_pohlig_hellman(MUNIT_UNUSED const MunitP
                                                        void *user_data_or_fixture) {
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
     unsigned i;
-    uint64_t cycles_start[data->iterations];
-    uint64_t cycles_stop[data->iterations];
-    tspec_t time_start[data->iterations];
-    tspec_t time_stop[data->iterations];
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
 
     scalar_t c, d, k;
     quadratic_field_element_t A, yP, yQ, zQ, t, y, x, a;
@@ -201,10 +201,10 @@ static MunitResult test_two_dimensional_ladder(MUNIT_UNUSED const MunitParameter
 
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
     unsigned i;
-    uint64_t cycles_start[data->iterations];
-    uint64_t cycles_stop[data->iterations];
-    tspec_t time_start[data->iterations];
-    tspec_t time_stop[data->iterations];
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
 
     quadratic_field_element_t A;
     sidh_private_key_t sk_alice, sk_bob;
@@ -216,10 +216,11 @@ static MunitResult test_two_dimensional_ladder(MUNIT_UNUSED const MunitParameter
     sidh_get_public_key_from_private_key_alice(&pk_alice, &sk_alice);
 
     get_curve_from_points(&A, pk_alice.P, pk_alice.Q, pk_alice.P_minus_Q);
+    canonical_basis(&pk, A);
 
     for (i = 0; i < data->iterations; i++) {
-        random_bob_private_key(sk_bob.key);
-        random_bob_private_key(z);
+        random_bob_scalar(sk_bob.key);
+        random_bob_scalar(z);
 
 
         get_clock(&time_start[i]);
@@ -234,6 +235,85 @@ static MunitResult test_two_dimensional_ladder(MUNIT_UNUSED const MunitParameter
     return MUNIT_OK;
 }
 
+static MunitResult test_two_dimensional_normalized_ladder(MUNIT_UNUSED const MunitParameter params[],
+                                                          void *user_data_or_fixture) {
+
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A;
+    sidh_private_key_t sk_alice, sk_bob;
+    sidh_public_key_t pk_alice, pk = {0};
+    x_only_point_t T;
+    scalar_t z;
+
+    sidh_generate_private_key_alice(&sk_alice, &data->shake_st);
+    sidh_get_public_key_from_private_key_alice(&pk_alice, &sk_alice);
+
+    get_curve_from_points(&A, pk_alice.P, pk_alice.Q, pk_alice.P_minus_Q);
+    canonical_basis(&pk, A);
+
+    for (i = 0; i < data->iterations; i++) {
+        random_bob_scalar(sk_bob.key);
+        random_bob_scalar(z);
+
+
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        two_dimensional_normalized_ladder_bob(&T, pk.P, pk.Q, pk.P_minus_Q, z, sk_bob.key, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+
+    }
+    report("PoK Two Dimensional Normalized Ladder", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult test_two_dimensional_normalized_ladder_pair(MUNIT_UNUSED const MunitParameter params[],
+                                                               void *user_data_or_fixture) {
+
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i, j;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A[2];
+    sidh_private_key_t sk_alice, sk_bob;
+    sidh_public_key_t pk_alice;
+    x_only_point_t P[2], Q[2], P_minus_Q[2], T[2];
+    scalar_t z;
+
+    // E₂ and E₃ of a challenge-0 verification
+    for (j = 0; j < 2; j++) {
+        sidh_generate_private_key_alice(&sk_alice, &data->shake_st);
+        sidh_get_public_key_from_private_key_alice(&pk_alice, &sk_alice);
+        get_curve_from_points(&A[j], pk_alice.P, pk_alice.Q, pk_alice.P_minus_Q);
+        canonical_basis_projective(&P[j], &Q[j], &P_minus_Q[j], A[j]);
+    }
+
+    for (i = 0; i < data->iterations; i++) {
+        random_bob_scalar(sk_bob.key);
+        random_bob_scalar(z);
+
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        two_dimensional_normalized_ladder_bob_pair(T, P, Q, P_minus_Q, z, sk_bob.key, A);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(T);
+    }
+    report("PoK Two Dimensional Normalized Ladder (pair of curves)", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
 /*
  * Register benchmark cases
  */
@@ -244,6 +324,8 @@ MunitTest benchmark_pok[] = {
         BENCHMARK(test_canonical_basis_naive, benchmark_setup, benchmark_teardown, benchmark_iterations),
         BENCHMARK(test_two_dimensional_pohlig_hellman, benchmark_setup, benchmark_teardown, benchmark_iterations),
         BENCHMARK(test_two_dimensional_ladder, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(test_two_dimensional_normalized_ladder, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(test_two_dimensional_normalized_ladder_pair, benchmark_setup, benchmark_teardown, benchmark_iterations),
         TEST_END
 };
 
@@ -7,23 +7,23 @@ static MunitResult key_gen_and_agreement(MUNIT_UNUSED const MunitParameter param
 
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
     unsigned i;
-    uint64_t cycles_gen_alice_start[data->iterations];
-    uint64_t cycles_gen_alice_stop[data->iterations];
-    uint64_t cycles_gen_bob_start[data->iterations];
-    uint64_t cycles_gen_bob_stop[data->iterations];
-    uint64_t cycles_agree_alice_start[data->iterations];
-    uint64_t cycles_agree_alice_stop[data->iterations];
-    uint64_t cycles_agree_bob_start[data->iterations];
-    uint64_t cycles_agree_bob_stop[data->iterations];
+    uint64_t *cycles_gen_alice_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_gen_alice_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_gen_bob_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_gen_bob_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_agree_alice_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_agree_alice_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_agree_bob_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_agree_bob_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
 
-    tspec_t time_gen_alice_start[data->iterations];
-    tspec_t time_gen_alice_stop[data->iterations];
-    tspec_t time_gen_bob_start[data->iterations];
-    tspec_t time_gen_bob_stop[data->iterations];
-    tspec_t time_agree_alice_start[data->iterations];
-    tspec_t time_agree_alice_stop[data->iterations];
-    tspec_t time_agree_bob_start[data->iterations];
-    tspec_t time_agree_bob_stop[data->iterations];
+    tspec_t *time_gen_alice_start = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_gen_alice_stop = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_gen_bob_start = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_gen_bob_stop = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_agree_alice_start = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_agree_alice_stop = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_agree_bob_start = munit_malloc(sizeof(tspec_t) * data->iterations);
+    tspec_t *time_agree_bob_stop = munit_malloc(sizeof(tspec_t) * data->iterations);
 
     sidh_private_key_t sk_alice, sk_bob;
     sidh_public_key_t pk_alice, pk_bob;
@@ -72,6 +72,22 @@ static MunitResult key_gen_and_agreement(MUNIT_UNUSED const MunitParameter param
            time_agree_alice_stop, data->iterations);
     report("SIDH key key agreement Bob", cycles_agree_bob_start, cycles_agree_bob_stop, time_agree_bob_start,
            time_agree_bob_stop, data->iterations);
+    free(cycles_gen_alice_start);
+    free(cycles_gen_alice_stop);
+    free(cycles_gen_bob_start);
+    free(cycles_gen_bob_stop);
+    free(cycles_agree_alice_start);
+    free(cycles_agree_alice_stop);
+    free(cycles_agree_bob_start);
+    free(cycles_agree_bob_stop);
+    free(time_gen_alice_start);
+    free(time_gen_alice_stop);
+    free(time_gen_bob_start);
+    free(time_gen_bob_stop);
+    free(time_agree_alice_start);
+    free(time_agree_alice_stop);
+    free(time_agree_bob_start);
+    free(time_agree_bob_stop);
     return MUNIT_OK;
 }
 
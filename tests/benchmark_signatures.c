@@ -6,18 +6,18 @@
 static MunitResult sign_verify_message(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
     benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
     unsigned i, check = 0;
-    uint64_t cycles_gen_start[data->iterations];
-    uint64_t cycles_gen_stop[data->iterations];
-    uint64_t cycles_sign_start[data->iterations];
-    uint64_t cycles_sign_stop[data->iterations];
-    uint64_t cycles_ver_start[data->iterations];
-    uint64_t cycles_ver_stop[data->iterations];
-    struct timespec time_gen_start[data->iterations];
-    struct timespec time_gen_stop[data->iterations];
-    struct timespec time_sign_start[data->iterations];
-    struct timespec time_sign_stop[data->iterations];
-    struct timespec time_ver_start[data->iterations];
-    struct timespec time_ver_stop[data->iterations];
+    uint64_t *cycles_gen_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_gen_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_sign_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_sign_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_ver_start = munit_malloc(sizeof(uint64_t) * data->iterations);
+    uint64_t *cycles_ver_stop = munit_malloc(sizeof(uint64_t) * data->iterations);
+    struct timespec *time_gen_start = munit_malloc(sizeof(struct timespec) * data->iterations);
+    struct timespec *time_gen_stop = munit_malloc(sizeof(struct timespec) * data->iterations);
+    struct timespec *time_sign_start = munit_malloc(sizeof(struct timespec) * data->iterations);
+    struct timespec *time_sign_stop = munit_malloc(sizeof(struct timespec) * data->iterations);
+    struct timespec *time_ver_start = munit_malloc(sizeof(struct timespec) * data->iterations);
+    struct timespec *time_ver_stop = munit_malloc(sizeof(struct timespec) * data->iterations);
 
     uint8_t private_key[SECRET_KEY_BYTES];
     uint8_t public_key[PUBLIC_KEY_BYTES];
@@ -53,6 +53,137 @@ static MunitResult sign_verify_message(MUNIT_UNUSED const MunitParameter params[
            data->iterations);
     report("SI-sign Verify", cycles_ver_start, cycles_ver_stop, time_ver_start, time_ver_stop,
            data->iterations);
+    free(cycles_gen_start);
+    free(cycles_gen_stop);
+    free(cycles_sign_start);
+    free(cycles_sign_stop);
+    free(cycles_ver_start);
+    free(cycles_ver_stop);
+    free(time_gen_start);
+    free(time_gen_stop);
+    free(time_sign_start);
+    free(time_sign_stop);
+    free(time_ver_start);
+    free(time_ver_stop);
+    return MUNIT_OK;
+}
+
+// Digest of a large message: the flat SHAKE256 path against the tree digest on one thread and on all cores.
+// Threads show up in the CPU time, so compare the cycle counts
+static char *digest_iterations[] = {"10", NULL};
+static char *digest_message_lengths[] = {"67108864", NULL};
+
+static MunitParameterEnum digest_parameters[] = {
+        {"iterations", digest_iterations},
+        {"mlen", digest_message_lengths},
+        PARAM_END
+};
+
+static MunitResult message_digest(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    const char *titles[] = {"Digest SHAKE256", "Digest tree (1 thread)", "Digest tree (all cores)"};
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    struct timespec *time_start = data->time_start;
+    struct timespec *time_stop = data->time_stop;
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+    uint8_t *message = malloc(data->message_num_bytes);
+
+    shake256(message, data->message_num_bytes, data->seed, KECCAK_SEED_LEN);
+    for (unsigned mode = 0; mode < 3; mode++) {
+        for (long i = 0; i < data->iterations; i++) {
+            get_clock(&time_start[i]);
+            get_cycles(&cycles_start[i]);
+            if (mode == 0) {
+                shake256(digest, MESSAGE_DIGEST_BYTES, message, data->message_num_bytes);
+            } else {
+                sidh_tree_digest(digest, message, data->message_num_bytes, (mode == 1) ? 1 : 0);
+            }
+            get_cycles(&cycles_stop[i]);
+            get_clock(&time_stop[i]);
+            escape(digest);
+        }
+        report(titles[mode], cycles_start, cycles_stop, time_start, time_stop, data->iterations);
+    }
+    free(message);
+    return MUNIT_OK;
+}
+
+// Rejection cost of a forged signature: full verification against fail-fast verification
+static MunitResult verify_forged(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    struct timespec *time_start = data->time_start;
+    struct timespec *time_stop = data->time_stop;
+    uint8_t private_key[SECRET_KEY_BYTES];
+    uint8_t public_key[PUBLIC_KEY_BYTES];
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t message[data->message_num_bytes];
+    unsigned check = 0;
+
+    shake256(message, data->message_num_bytes, data->seed, KECCAK_SEED_LEN);
+    sidh_signature_key_generation(private_key, public_key, &data->shake_st);
+    sidh_signature_sign(signature, message, data->message_num_bytes, private_key, public_key, &data->shake_st);
+    // Corrupts the response of the first round
+    signature[COMMITMENT_BYTES * SECURITY_BITS] ^= 0x01;
+
+    for (unsigned mode = 0; mode < 2; mode++) {
+        for (long i = 0; i < data->iterations; i++) {
+            get_clock(&time_start[i]);
+            get_cycles(&cycles_start[i]);
+            if (mode == 0) {
+                check |= !sidh_signature_verify(signature, message, data->message_num_bytes, public_key);
+            } else {
+                check |= !sidh_signature_verify_fail_fast(signature, message, data->message_num_bytes, public_key);
+            }
+            get_cycles(&cycles_stop[i]);
+            get_clock(&time_stop[i]);
+        }
+        report((mode == 0) ? "SI-sign Verify forged" : "SI-sign Verify forged (fail-fast)",
+               cycles_start, cycles_stop, time_start, time_stop, data->iterations);
+    }
+    assert(check == 0);
+    return MUNIT_OK;
+}
+
+// Provisioning: a batch of keys one at a time, then through the batch API on one thread and on all cores.
+// Threads show up in the CPU time, so compare the cycle counts
+#define KEY_GENERATION_BATCH 64
+
+static MunitResult key_generation_batch(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    const char *titles[] = {"KeyGen x64 (one at a time)", "KeyGen x64 batch (1 thread)", "KeyGen x64 batch (all cores)"};
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    struct timespec *time_start = data->time_start;
+    struct timespec *time_stop = data->time_stop;
+    uint8_t *private_keys = malloc(KEY_GENERATION_BATCH * SECRET_KEY_BYTES);
+    uint8_t *public_keys = malloc(KEY_GENERATION_BATCH * PUBLIC_KEY_BYTES);
+    unsigned check = 0;
+
+    for (unsigned mode = 0; mode < 3; mode++) {
+        for (long i = 0; i < data->iterations; i++) {
+            get_clock(&time_start[i]);
+            get_cycles(&cycles_start[i]);
+            if (mode == 0) {
+                for (unsigned k = 0; k < KEY_GENERATION_BATCH; k++) {
+                    check |= sidh_signature_key_generation(&private_keys[SECRET_KEY_BYTES * k],
+                                                           &public_keys[PUBLIC_KEY_BYTES * k], &data->shake_st);
+                }
+            } else {
+                check |= sidh_signature_key_generation_batch(private_keys, public_keys, KEY_GENERATION_BATCH,
+                                                             &data->shake_st, (mode == 1) ? 1 : 0);
+            }
+            get_cycles(&cycles_stop[i]);
+            get_clock(&time_stop[i]);
+            escape(public_keys);
+        }
+        report(titles[mode], cycles_start, cycles_stop, time_start, time_stop, data->iterations);
+    }
+    assert(check == EXIT_SUCCESS);
+    free(public_keys);
+    free(private_keys);
     return MUNIT_OK;
 }
 
@@ -64,5 +195,8 @@ static MunitResult sign_verify_message(MUNIT_UNUSED const MunitParameter params[
 MunitTest benchmark_signatures[] = {
 //        BENCHMARK(key_generation, signature_setup, signature_teardown, benchmark_iterations),
         BENCHMARK(sign_verify_message, benchmark_setup, benchmark_teardown, benchmark_message_lengths),
+        BENCHMARK(verify_forged, benchmark_setup, benchmark_teardown, benchmark_message_lengths),
+        BENCHMARK(message_digest, benchmark_setup, benchmark_teardown, digest_parameters),
+        BENCHMARK(key_generation_batch, benchmark_setup, benchmark_teardown, benchmark_iterations),
         TEST_END
 };
@@ -0,0 +1,315 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "benchmark.h"
+#include <isogeny.h>
+#include <twisted_edwards.h>
+
+// Unit costs consumed by python_utils/strategy-tuner.py: the report titles below are parsed by the tuner, so keep them
+// in sync with it.
+
+// Same timer calls with nothing in between: the stop clock falls inside the cycle window, so it is subtracted by the tuner
+static MunitResult strategy_timer_overhead(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+    }
+    report("Strategy timer overhead", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static void strategy_setup_alice(x_only_point_t points[2],
+                                 x_only_point_t *K,
+                                 projective_curve_alice_t *curve,
+                                 quadratic_field_element_t *A) {
+    x_only_point_t P = {0}, Q = {0}, P_minus_Q = {0};
+    scalar_t k = {0};
+
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(A);
+    A->re[0] = 6;
+    quadratic_field_to_montgomery_representation(A, *A);
+    to_projective_curve_alice(curve, *A);
+
+    initialize_generators_alice(&P.X, &Q.X, &P_minus_Q.X);
+    quadratic_field_set_to_one(&P.Z);
+    quadratic_field_set_to_one(&Q.Z);
+    quadratic_field_set_to_one(&P_minus_Q.Z);
+    random_bob_private_key(k);
+    x_only_three_point_ladder(K, P.X, Q.X, P_minus_Q.X, k, SUBGROUP_ORDER_BITS_ALICE, *A);
+    x_only_point_copy(&points[0], P);
+    x_only_point_copy(&points[1], Q);
+}
+
+static void strategy_setup_bob(x_only_point_t points[2],
+                               x_only_point_t *K,
+                               projective_curve_bob_t *curve,
+                               quadratic_field_element_t *A) {
+    x_only_point_t P = {0}, Q = {0}, P_minus_Q = {0};
+    scalar_t k = {0};
+
+    // E₀ : y² = x³ + 6x² + x
+    quadratic_field_set_to_zero(A);
+    A->re[0] = 6;
+    quadratic_field_to_montgomery_representation(A, *A);
+    to_projective_curve_bob(curve, *A);
+
+    initialize_generators_bob(&P.X, &Q.X, &P_minus_Q.X);
+    quadratic_field_set_to_one(&P.Z);
+    quadratic_field_set_to_one(&Q.Z);
+    quadratic_field_set_to_one(&P_minus_Q.Z);
+    random_bob_private_key(k);
+    x_only_three_point_ladder(K, P.X, Q.X, P_minus_Q.X, k, SUBGROUP_ORDER_BITS_BOB, *A);
+    x_only_point_copy(&points[0], P);
+    x_only_point_copy(&points[1], Q);
+}
+
+static MunitResult strategy_alice_doublings(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A;
+    projective_curve_alice_t curve;
+    x_only_point_t points[2], K, T;
+
+    strategy_setup_alice(points, &K, &curve, &A);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_multiple_point_doublings(&T, K, 2, curve);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("Strategy Alice point multiplication", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult strategy_alice_evaluation(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, isogeny_coefficients[3];
+    projective_curve_alice_t curve;
+    x_only_point_t points[2], images[2], K;
+
+    strategy_setup_alice(points, &K, &curve, &A);
+    x_only_multiple_point_doublings(&K, K, EXPONENT_ALICE - 2, curve);
+    x_only_4_isogeny(&curve, isogeny_coefficients, K);
+    for (i = 0; i < data->iterations; i++) {
+        memcpy(images, points, sizeof(images));
+        // A pair of points, as the strategy loops evaluate them
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_4_isogeny_evaluation_batch(images, 2, isogeny_coefficients);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(images);
+    }
+    report("Strategy Alice isogeny evaluation pair", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult strategy_bob_triplings(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A;
+    projective_curve_bob_t curve;
+    x_only_point_t points[2], K, T;
+
+    strategy_setup_bob(points, &K, &curve, &A);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_point_tripling(&T, K, curve);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("Strategy Bob point multiplication", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult strategy_bob_evaluation(MUNIT_UNUSED const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    quadratic_field_element_t A, isogeny_coefficients[2];
+    projective_curve_bob_t curve;
+    x_only_point_t points[2], images[2], K;
+
+    strategy_setup_bob(points, &K, &curve, &A);
+    x_only_multiple_point_triplings(&K, K, EXPONENT_BOB - 1, curve);
+    x_only_3_isogeny(&curve, isogeny_coefficients, K);
+    for (i = 0; i < data->iterations; i++) {
+        memcpy(images, points, sizeof(images));
+        // A pair of points, as the strategy loops evaluate them
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        x_only_3_isogeny_evaluation_batch(images, 2, isogeny_coefficients);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(images);
+    }
+    report("Strategy Bob isogeny evaluation pair", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static void strategy_setup_pohlig_hellman(projective_point_t *P,
+                                          projective_point_t *Q,
+                                          projective_point_t table[4],
+                                          twisted_edwards_curve_t *curve) {
+    int i;
+    quadratic_field_element_t A, y, t;
+    projective_curve_bob_t curve_bob;
+    x_only_point_t points[2], K;
+
+    strategy_setup_bob(points, &K, &curve_bob, &A);
+
+    // y-coordinates as square-roots of x³ + Ax² + x (affine generators)
+    quadratic_field_square(&t, points[0].X);
+    quadratic_field_multiplication(&y, A, t);
+    quadratic_field_addition(&y, y, points[0].X);
+    quadratic_field_multiplication(&t, t, points[0].X);
+    quadratic_field_addition(&y, y, t);
+    quadratic_field_is_square(&y, y);
+    to_twisted_edwards_model(P, points[0].X, y);
+
+    quadratic_field_square(&t, points[1].X);
+    quadratic_field_multiplication(&y, A, t);
+    quadratic_field_addition(&y, y, points[1].X);
+    quadratic_field_multiplication(&t, t, points[1].X);
+    quadratic_field_addition(&y, y, t);
+    quadratic_field_is_square(&y, y);
+    to_twisted_edwards_model(Q, points[1].X, y);
+
+    quadratic_field_copy(&curve->a, A);
+    prime_field_addition(curve->a.re, curve->a.re, MONTGOMERY_CONSTANT_ONE);
+    prime_field_addition(curve->a.re, curve->a.re, MONTGOMERY_CONSTANT_ONE);
+    quadratic_field_copy(&curve->d, A);
+    prime_field_subtraction(curve->d.re, curve->d.re, MONTGOMERY_CONSTANT_ONE);
+    prime_field_subtraction(curve->d.re, curve->d.re, MONTGOMERY_CONSTANT_ONE);
+
+    projective_point_copy(&table[0], *P);
+    projective_point_copy(&table[1], *Q);
+    for (i = 1; i < EXPONENT_BOB; i++) {
+        projective_point_tripling(&table[0], table[0], curve->a);
+        projective_point_tripling(&table[1], table[1], curve->a);
+    }
+    projective_point_addition(&table[2], table[0], table[1], *curve);
+    projective_point_addition(&table[3], table[2], table[1], *curve);
+}
+
+static MunitResult strategy_pohlig_hellman_triplings(MUNIT_UNUSED const MunitParameter params[],
+                                                     void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    projective_point_t P, Q, T, table[4];
+    twisted_edwards_curve_t curve;
+
+    strategy_setup_pohlig_hellman(&P, &Q, table, &curve);
+    for (i = 0; i < data->iterations; i++) {
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        projective_point_tripling(&T, P, curve.a);
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("Strategy Pohlig-Hellman point multiplication", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+static MunitResult strategy_pohlig_hellman_steps(MUNIT_UNUSED const MunitParameter params[],
+                                                 void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    unsigned i;
+    uint64_t *cycles_start = data->cycles_start;
+    uint64_t *cycles_stop = data->cycles_stop;
+    tspec_t *time_start = data->time_start;
+    tspec_t *time_stop = data->time_stop;
+
+    unsigned j;
+    projective_point_t P, Q, T, table[4], digits[9];
+    twisted_edwards_curve_t curve;
+
+    strategy_setup_pohlig_hellman(&P, &Q, table, &curve);
+
+    // The nine digits (cᵢ, dᵢ) in {0,1,2}²: the neutral point and ±table[j]
+    projective_point_copy(&T, table[0]);
+    quadratic_field_negate(&T.X, T.X);
+    projective_point_addition(&digits[0], table[0], T, curve);
+    for (i = 0; i < 4; i++) {
+        projective_point_copy(&digits[2 * i + 1], table[i]);
+        projective_point_copy(&digits[2 * i + 2], table[i]);
+        quadratic_field_negate(&digits[2 * i + 2].X, digits[2 * i + 2].X);
+    }
+
+    for (i = 0; i < data->iterations; i++) {
+        projective_point_copy(&T, P);
+        // All the nine digits, the tuner takes the average
+        get_clock(&time_start[i]);
+        get_cycles(&cycles_start[i]);
+        for (j = 0; j < 9; j++) {
+            pohlig_hellman_steps_bob(&T, P, Q, digits[j], table, curve);
+        }
+        get_clock(&time_stop[i]);
+        get_cycles(&cycles_stop[i]);
+        escape(&T);
+    }
+    report("Strategy Pohlig-Hellman evaluation nine digits", cycles_start, cycles_stop, time_start,
+           time_stop, data->iterations);
+    return MUNIT_OK;
+}
+
+/*
+ * Register benchmark cases
+ */
+
+// NOLINTNEXTLINE
+MunitTest benchmark_strategy[] = {
+        BENCHMARK(strategy_timer_overhead, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(strategy_alice_doublings, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(strategy_alice_evaluation, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(strategy_bob_triplings, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(strategy_bob_evaluation, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(strategy_pohlig_hellman_triplings, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        BENCHMARK(strategy_pohlig_hellman_steps, benchmark_setup, benchmark_teardown, benchmark_iterations),
+        TEST_END
+};
@@ -0,0 +1,167 @@
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "benchmark.h"
+#include <signature.h>
+
+// Operations per thread and per phase, the largest number of threads (0: one per online core), and the thread
+// counts in between: powers of two and the largest (doubling), or every one of them (linear)
+static char *throughput_iterations[] = {"2", NULL};
+static char *throughput_threads[] = {"0", NULL};
+static char *throughput_sweeps[] = {"doubling", NULL};
+
+static MunitParameterEnum throughput_parameters[] = {
+        {"iterations", throughput_iterations},
+        {"threads", throughput_threads},
+        {"sweep", throughput_sweeps},
+        PARAM_END
+};
+
+typedef struct {
+    pthread_barrier_t *barrier;
+    uint8_t seed[KECCAK_SEED_LEN];
+    long operations;
+    long message_num_bytes;
+    double seconds[2];          // sign, verify
+    unsigned failures;
+} throughput_worker_t;
+
+// Each phase starts and ends on the barrier, which the reporting thread joins to read the wall clock
+static void *throughput_worker(void *argument) {
+    throughput_worker_t *worker = (throughput_worker_t *) argument;
+    uint8_t private_key[SECRET_KEY_BYTES];
+    uint8_t public_key[PUBLIC_KEY_BYTES];
+    uint8_t *signatures = malloc(worker->operations * SIGNATURE_BYTES);
+    uint8_t *message = malloc(worker->message_num_bytes);
+    tspec_t start, stop;
+    keccak_state shake_st;
+
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, worker->seed, KECCAK_SEED_LEN);
+    shake256_finalize(&shake_st);
+    shake256_squeeze(message, worker->message_num_bytes, &shake_st);
+    worker->failures = sidh_signature_key_generation(private_key, public_key, &shake_st);
+
+    pthread_barrier_wait(worker->barrier);
+    get_wall_clock(&start);
+    for (long i = 0; i < worker->operations; i++) {
+        worker->failures |= sidh_signature_sign(&signatures[SIGNATURE_BYTES * i], message,
+                                                worker->message_num_bytes, private_key, public_key, &shake_st);
+    }
+    get_wall_clock(&stop);
+    worker->seconds[0] = elapsed_seconds(&start, &stop);
+    pthread_barrier_wait(worker->barrier);
+
+    pthread_barrier_wait(worker->barrier);
+    get_wall_clock(&start);
+    for (long i = 0; i < worker->operations; i++) {
+        worker->failures |= sidh_signature_verify(&signatures[SIGNATURE_BYTES * i], message,
+                                                  worker->message_num_bytes, public_key);
+    }
+    get_wall_clock(&stop);
+    worker->seconds[1] = elapsed_seconds(&start, &stop);
+    pthread_barrier_wait(worker->barrier);
+
+    free(message);
+    free(signatures);
+    return NULL;
+}
+
+// Aggregate rate, scaling efficiency against the single-thread rate, and the spread of the per-thread rates
+static void throughput_report(const char *title, unsigned threads, long operations, double seconds,
+                              const throughput_worker_t *workers, unsigned phase, double *single_thread_rate) {
+    double rate = (double) (threads * operations) / seconds;
+    double mean = 0, variance = 0, thread_rate, minimum = INFINITY, maximum = 0;
+
+    for (unsigned t = 0; t < threads; t++) {
+        thread_rate = (double) operations / workers[t].seconds[phase];
+        mean += thread_rate;
+        minimum = (thread_rate < minimum) ? thread_rate : minimum;
+        maximum = (thread_rate > maximum) ? thread_rate : maximum;
+    }
+    mean /= threads;
+    for (unsigned t = 0; t < threads; t++) {
+        thread_rate = (double) operations / workers[t].seconds[phase];
+        variance += (thread_rate - mean) * (thread_rate - mean);
+    }
+    variance /= threads;
+    if (threads == 1) { *single_thread_rate = rate; }
+
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%s with %u threads, %ld per thread",
+                  title, threads, operations);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%lf\t\t per second (wall clock)", rate);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%lf\t\t scaling efficiency",
+                  rate / (threads * *single_thread_rate));
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%lf\t\t per second per thread [min]", minimum);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%lf\t\t per second per thread [max]", maximum);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, "%lf\t\t per thread [coefficient of variation]",
+                  sqrt(variance) / mean);
+    munit_logf_ex(BENCHMARK_LOG_LEVEL, BENCHMARK_LOG_FILE, 0, " ");
+}
+
+// Concurrent signers, then concurrent verifiers, for 1 .. maximum threads
+static MunitResult sign_verify_throughput(const MunitParameter params[], void *user_data_or_fixture) {
+    benchmark_data_t *data = (benchmark_data_t *) user_data_or_fixture;
+    const char *titles[] = {"SI-sign Sign throughput", "SI-sign Verify throughput"};
+    const char *threads_parameter = munit_parameters_get(params, "threads");
+    long maximum_threads = (threads_parameter != NULL) ? strtol(threads_parameter, NULL, 10) : 0;
+    const char *sweep_parameter = munit_parameters_get(params, "sweep");
+    uint8_t linear = (sweep_parameter != NULL) && (strcmp(sweep_parameter, "linear") == 0);
+    double single_thread_rate[2] = {0};
+    unsigned failures = 0;
+    tspec_t start, stop;
+    double seconds;
+
+    if (maximum_threads <= 0) {
+        maximum_threads = sysconf(_SC_NPROCESSORS_ONLN);
+        maximum_threads = (maximum_threads > 0) ? maximum_threads : 1;
+    }
+
+    throughput_worker_t workers[maximum_threads];
+    pthread_t threads[maximum_threads];
+    for (unsigned n = 1, next; n <= (unsigned) maximum_threads; n = next) {
+        next = linear ? n + 1 : 2 * n;
+        if (n < (unsigned) maximum_threads && next > (unsigned) maximum_threads) { next = (unsigned) maximum_threads; }
+        pthread_barrier_t barrier;
+        pthread_barrier_init(&barrier, NULL, n + 1);
+        for (unsigned t = 0; t < n; t++) {
+            workers[t].barrier = &barrier;
+            memcpy(workers[t].seed, data->seed, KECCAK_SEED_LEN);
+            workers[t].seed[0] ^= (uint8_t) n;
+            workers[t].seed[1] ^= (uint8_t) t;
+            workers[t].operations = data->iterations;
+            workers[t].message_num_bytes = data->message_num_bytes;
+            munit_assert_int(pthread_create(&threads[t], NULL, throughput_worker, &workers[t]), ==, 0);
+        }
+
+        for (unsigned phase = 0; phase < 2; phase++) {
+            pthread_barrier_wait(&barrier);
+            get_wall_clock(&start);
+            pthread_barrier_wait(&barrier);
+            get_wall_clock(&stop);
+            seconds = elapsed_seconds(&start, &stop);
+            throughput_report(titles[phase], n, data->iterations, seconds, workers, phase, &single_thread_rate[phase]);
+        }
+
+        for (unsigned t = 0; t < n; t++) {
+            pthread_join(threads[t], NULL);
+            failures |= workers[t].failures;
+        }
+        pthread_barrier_destroy(&barrier);
+    }
+    assert(failures == EXIT_SUCCESS);
+    return MUNIT_OK;
+}
+
+/*
+ * Register benchmark cases
+ */
+
+// NOLINTNEXTLINE
+MunitTest benchmark_throughput[] = {
+        BENCHMARK(sign_verify_throughput, benchmark_setup, benchmark_teardown, throughput_parameters),
+        TEST_END
+};
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "utilities.h"
+#include <daemon.h>
+
+static MunitResult daemon_sign_and_verify(MUNIT_UNUSED const MunitParameter params[],
+                                          MUNIT_UNUSED void *user_data_or_fixture) {
+    uint64_t message_length = 1000;
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t message[message_length];
+    sidh_daemon_key_t key;
+    sidh_daemon_stats_t stats;
+    char socket_path[64];
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(key.private_key, key.public_key, &shake_st));
+
+    seed[0]++;
+    shake256(message, sizeof(message), seed, sizeof(seed));
+
+    snprintf(socket_path, sizeof(socket_path), "/tmp/sidh-signd-test-%ld.sock", (long) getpid());
+    sidh_daemon_t *daemon = sidh_daemon_start(socket_path, &key, 1, 0);
+    assert_not_null(daemon);
+    struct stat socket_stat;
+    assert_int(stat(socket_path, &socket_stat), ==, 0);
+    assert_int(socket_stat.st_mode & 0777, ==, 0600);
+    int connection = sidh_daemon_connect(socket_path);
+    assert_int(connection, >=, 0);
+
+    // A client stalled in the middle of a frame holds up neither the other clients nor the shutdown
+    int stalled = sidh_daemon_connect(socket_path);
+    assert_int(stalled, >=, 0);
+    uint8_t partial_header[SIDH_DAEMON_HEADER_BYTES / 2] = {0};
+    assert_int(write(stalled, partial_header, sizeof(partial_header)), ==, (int) sizeof(partial_header));
+
+    // Unknown keys and empty messages are refused without reaching the engine
+    assert_uint8(EXIT_FAILURE, ==, sidh_daemon_sign(connection, 1, signature, message, message_length));
+    assert_uint8(EXIT_FAILURE, ==, sidh_daemon_sign(connection, 0, signature, message, 0));
+
+    assert_uint8(EXIT_SUCCESS, ==, sidh_daemon_sign(connection, 0, signature, message, message_length));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verify(signature, message, message_length, key.public_key));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_daemon_verify(connection, signature, message, message_length, key.public_key));
+
+    assert_uint8(EXIT_SUCCESS, ==, sidh_daemon_stats(connection, &stats));
+    assert_uint64(stats.queue_depth, ==, 0);
+    assert_uint64(stats.completed, ==, 2);
+    assert_uint64(stats.average_latency_us, <=, stats.maximum_latency_us);
+
+    sidh_daemon_disconnect(connection);
+    sidh_daemon_stop(daemon);
+    sidh_daemon_disconnect(stalled);
+    assert_int(access(socket_path, F_OK), !=, 0);
+    return MUNIT_OK;
+}
+
+MunitTest test_daemon[] = {
+        TEST_CASE(daemon_sign_and_verify),
+        TEST_END
+};
@@ -12,14 +12,25 @@ extern MunitTest test_isogeny[];
 extern MunitTest test_sidh[];
 extern MunitTest test_pok[];
 extern MunitTest test_signature[];
+extern MunitTest test_fips202[];
+extern MunitTest test_engine[];
+extern MunitTest test_daemon[];
+extern MunitTest test_verify_cache[];
+extern MunitTest test_key_store[];
 
 /**
  * Benchmarks
  */
 extern MunitTest benchmark_prime_fields[];
 extern MunitTest benchmark_quadratic_fields[];
+extern MunitTest benchmark_ecc[];
+extern MunitTest benchmark_isogeny[];
 extern MunitTest benchmark_sidh[];
 extern MunitTest benchmark_pok[];
 extern MunitTest benchmark_signatures[];
+extern MunitTest benchmark_strategy[];
+extern MunitTest benchmark_throughput[];
+extern MunitTest benchmark_counters[];
+extern MunitTest benchmark_memory[];
 
 #endif //SIDH_POK_TEST_DECLARATIONS_H
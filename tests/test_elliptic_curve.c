@@ -117,6 +117,19 @@ static MunitResult curve_alice(MUNIT_UNUSED const MunitParameter params[],
                               a);
     assert_true(x_only_point_is_equal(T, R));
 
+    // Fixed-base ladder, and the batch normalization of its output
+    x_only_fixed_base_t table[SUBGROUP_ORDER_BITS_ALICE];
+    x_only_point_t points[2];
+    x_only_fixed_base_table(table, Q.X, SUBGROUP_ORDER_BITS_ALICE, a);
+    x_only_three_point_ladder_fixed_base(&points[0], P.X, P_minus_Q.X, table, k, SUBGROUP_ORDER_BITS_ALICE);
+    assert_true(x_only_point_is_equal(R, points[0]));
+    x_only_point_copy(&points[1], P);
+    quadratic_field_addition(&points[1].X, points[1].X, points[1].X);
+    quadratic_field_addition(&points[1].Z, points[1].Z, points[1].Z);
+    x_only_points_to_affine(points, 2);
+    assert_true(x_only_point_is_equal_mixed(R, points[0].X));
+    assert_true(quadratic_field_is_equal(points[1].X, P.X));
+
     return MUNIT_OK;
 }
 
@@ -0,0 +1,80 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include "utilities.h"
+#include <engine.h>
+
+static void engine_callback(sidh_engine_job_t *job, void *user_data) {
+    atomic_int *completed = (atomic_int *) user_data;
+    atomic_fetch_add(completed, 1 + job->result);
+}
+
+static MunitResult engine_sign_and_verify(MUNIT_UNUSED const MunitParameter params[],
+                                          MUNIT_UNUSED void *user_data_or_fixture) {
+    uint64_t message_length = 10000;
+    uint8_t private_key[SECRET_KEY_BYTES] = {0};
+    uint8_t public_key[PUBLIC_KEY_BYTES] = {0};
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t forged_signature[SIGNATURE_BYTES] = {0};
+    uint8_t message[message_length];
+    sidh_engine_job_t *jobs = calloc(3, sizeof(sidh_engine_job_t));
+    atomic_int completed;
+
+    memset(message, 0, message_length);
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(private_key, public_key, &shake_st));
+
+    seed[0]++;
+    shake256(message, sizeof(message), seed, sizeof(seed));
+
+    sidh_engine_t *engine = sidh_engine_create(2);
+    assert_not_null(engine);
+
+    // Signing through a pollable future
+    jobs[0].kind = SIDH_ENGINE_JOB_SIGN;
+    jobs[0].priority = SIDH_ENGINE_PRIORITY_HIGH;
+    jobs[0].message = message;
+    jobs[0].message_length = message_length;
+    jobs[0].private_key = private_key;
+    jobs[0].public_key = public_key;
+    jobs[0].signature = signature;
+    assert_uint8(EXIT_SUCCESS, ==, sidh_engine_submit(engine, &jobs[0], &shake_st));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_engine_wait(&jobs[0]));
+    assert_uint8(1, ==, sidh_engine_poll(&jobs[0]));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verify(signature, message, message_length, public_key));
+
+    // Concurrent verifications through completion callbacks: a valid and a forged signature
+    memcpy(forged_signature, signature, SIGNATURE_BYTES);
+    forged_signature[0] ^= 0x01;
+    atomic_init(&completed, 0);
+    for (int i = 1; i < 3; i++) {
+        jobs[i].kind = SIDH_ENGINE_JOB_VERIFY;
+        jobs[i].priority = SIDH_ENGINE_PRIORITY_NORMAL;
+        jobs[i].message = message;
+        jobs[i].message_length = message_length;
+        jobs[i].public_key = public_key;
+        jobs[i].signature = (i == 1) ? signature : forged_signature;
+        jobs[i].callback = engine_callback;
+        jobs[i].user_data = &completed;
+        assert_uint8(EXIT_SUCCESS, ==, sidh_engine_submit(engine, &jobs[i], NULL));
+    }
+    // Pending jobs are completed before the workers exit
+    sidh_engine_destroy(engine);
+    assert_int(atomic_load(&completed), ==, (1 + EXIT_SUCCESS) + (1 + EXIT_FAILURE));
+    assert_uint8(EXIT_SUCCESS, ==, jobs[1].result);
+    assert_uint8(EXIT_FAILURE, ==, jobs[2].result);
+
+    free(jobs);
+    return MUNIT_OK;
+}
+
+MunitTest test_engine[] = {
+        TEST_CASE(engine_sign_and_verify),
+        TEST_END
+};
@@ -0,0 +1,57 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include <fips202x4.h>
+
+static MunitResult test_keccak_permutation(MUNIT_UNUSED const MunitParameter params[],
+                                           MUNIT_UNUSED void *user_data_or_fixture) {
+    uint64_t state[25] = {0};
+    uint64_t states[25][4] = {{0}};
+
+    // Keccak-f[1600] on the all-zero state
+    KeccakF1600_StatePermute(state);
+    assert_uint64(state[0], ==, 0xF1258F7940E1DDE7ULL);
+    assert_uint64(state[24], ==, 0xEAF1FF7B5CECA249ULL);
+
+    KeccakF1600_StatePermute4x(states);
+    for (int j = 0; j < 4; j++) {
+        for (int i = 0; i < 25; i++) {
+            assert_uint64(states[i][j], ==, state[i]);
+        }
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult test_shake256x4(MUNIT_UNUSED const MunitParameter params[],
+                                   MUNIT_UNUSED void *user_data_or_fixture) {
+    const size_t lengths[] = {0, 18, SHAKE256_RATE - 1, SHAKE256_RATE, 3 * SHAKE256_RATE + 5};
+    uint8_t in[4][3 * SHAKE256_RATE + 5], out[4][2 * SHAKE256_RATE + 7], expected[2 * SHAKE256_RATE + 7];
+    keccak_state states[4];
+
+    for (int j = 0; j < 4; j++) {
+        for (size_t i = 0; i < sizeof(in[j]); i++) { in[j][i] = (uint8_t) (i * 7 + j * 31); }
+    }
+
+    for (size_t k = 0; k < sizeof(lengths) / sizeof(lengths[0]); k++) {
+        shake256x4(out[0], out[1], out[2], out[3], sizeof(out[0]), in[0], in[1], in[2], in[3], lengths[k]);
+        for (int j = 0; j < 4; j++) {
+            shake256(expected, sizeof(expected), in[j], lengths[k]);
+            assert_memory_equal(sizeof(expected), out[j], expected);
+        }
+
+        // Split states continue as independent scalar sponges
+        shake256x4_split(states, in[0], in[1], in[2], in[3], lengths[k]);
+        for (int j = 0; j < 4; j++) {
+            shake256_squeeze(out[j], 3, &states[j]);
+            shake256_squeeze(&out[j][3], sizeof(out[j]) - 3, &states[j]);
+            shake256(expected, sizeof(expected), in[j], lengths[k]);
+            assert_memory_equal(sizeof(expected), out[j], expected);
+        }
+    }
+    return MUNIT_OK;
+}
+
+MunitTest test_fips202[] = {
+        TEST_CASE(test_keccak_permutation),
+        TEST_CASE(test_shake256x4),
+        TEST_END
+};
@@ -142,6 +142,64 @@ static MunitResult test_isogeny_bob(MUNIT_UNUSED const MunitParameter params[],
     return MUNIT_OK;
 }
 
+static MunitResult test_isogeny_evaluation_batch(MUNIT_UNUSED const MunitParameter params[],
+                                                 MUNIT_UNUSED void *user_data_or_fixture) {
+    int i;
+    x_only_point_t P = {0}, Q = {0}, P_minus_Q = {0}, K = {0}, batch[5], single[5];
+    scalar_t k = {0};
+
+    quadratic_field_element_t a = { .im = {0}, .re = {[0]=6}};
+    quadratic_field_element_t isogeny_coefficients[3];
+    quadratic_field_to_montgomery_representation(&a, a);
+
+    projective_curve_alice_t curve_a;
+    projective_curve_bob_t curve_b;
+    to_projective_curve_alice(&curve_a, a);
+
+    // +++++++ 4-isogeny: odd number of points, so both the interleaved loop and the tail are exercised
+    initialize_generators_alice(&P.X, &Q.X, &P_minus_Q.X);
+    quadratic_field_set_to_one(&P.Z);
+    quadratic_field_set_to_one(&Q.Z);
+    quadratic_field_set_to_one(&P_minus_Q.Z);
+    random_bob_private_key(k);
+    x_only_three_point_ladder(&K, P.X, Q.X, P_minus_Q.X, k, SUBGROUP_ORDER_BITS_ALICE, a);
+    x_only_point_copy(&batch[0], P);
+    x_only_point_copy(&batch[1], Q);
+    x_only_point_copy(&batch[2], P_minus_Q);
+    x_only_point_copy(&batch[3], K);
+    x_only_multiple_point_doublings(&K, K, EXPONENT_ALICE - 2, curve_a);
+    x_only_point_copy(&batch[4], K);
+    x_only_4_isogeny(&curve_a, isogeny_coefficients, K);
+    for (i = 0; i < 5; i++) {
+        x_only_4_isogeny_evaluation(&single[i], batch[i], isogeny_coefficients);
+    }
+    x_only_4_isogeny_evaluation_batch(batch, 5, isogeny_coefficients);
+    assert_memory_equal(sizeof(batch), batch, single);
+
+    // +++++++ 3-isogeny
+    to_projective_curve_bob(&curve_b, a);
+    initialize_generators_bob(&P.X, &Q.X, &P_minus_Q.X);
+    quadratic_field_set_to_one(&P.Z);
+    quadratic_field_set_to_one(&Q.Z);
+    quadratic_field_set_to_one(&P_minus_Q.Z);
+    random_bob_private_key(k);
+    x_only_three_point_ladder(&K, P.X, Q.X, P_minus_Q.X, k, SUBGROUP_ORDER_BITS_BOB, a);
+    x_only_point_copy(&batch[0], P);
+    x_only_point_copy(&batch[1], Q);
+    x_only_point_copy(&batch[2], P_minus_Q);
+    x_only_point_copy(&batch[3], K);
+    x_only_multiple_point_triplings(&K, K, EXPONENT_BOB - 1, curve_b);
+    x_only_point_copy(&batch[4], K);
+    x_only_3_isogeny(&curve_b, isogeny_coefficients, K);
+    for (i = 0; i < 5; i++) {
+        x_only_3_isogeny_evaluation(&single[i], batch[i], isogeny_coefficients);
+    }
+    x_only_3_isogeny_evaluation_batch(batch, 5, isogeny_coefficients);
+    assert_memory_equal(sizeof(batch), batch, single);
+
+    return MUNIT_OK;
+}
+
 
 /*
  * Register test cases
@@ -149,5 +207,6 @@ static MunitResult test_isogeny_bob(MUNIT_UNUSED const MunitParameter params[],
 MunitTest test_isogeny[] = {
         TEST_CASE(test_isogeny_alice),
         TEST_CASE(test_isogeny_bob),
+        TEST_CASE(test_isogeny_evaluation_batch),
         TEST_END
 };
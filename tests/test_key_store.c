@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <unistd.h>
+#include "test_declarations.h"
+#include "test_utils.h"
+#include <key_store.h>
+
+static MunitResult key_store_write_and_open(MUNIT_UNUSED const MunitParameter params[],
+                                            MUNIT_UNUSED void *user_data_or_fixture) {
+    uint8_t private_key[SECRET_KEY_BYTES];
+    uint8_t public_keys[5][PUBLIC_KEY_BYTES] = {{0}};
+    const sidh_prepared_public_key_t *stored;
+    sidh_prepared_public_key_t prepared;
+    char path[64];
+    FILE *file;
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    // Three keys, a duplicate, and an invalid all-zero key
+    for (int i = 0; i < 3; i++) {
+        assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(private_key, public_keys[i], &shake_st));
+    }
+    memcpy(public_keys[3], public_keys[1], PUBLIC_KEY_BYTES);
+
+    snprintf(path, sizeof(path), "/tmp/sidh-key-store-test-%ld.bin", (long) getpid());
+    assert_uint8(EXIT_SUCCESS, ==, sidh_key_store_write(path, (const uint8_t *) public_keys, 5));
+    sidh_key_store_t *store = sidh_key_store_open(path);
+    assert_not_null(store);
+    assert_uint64(sidh_key_store_size(store), ==, 4);
+    assert_null(sidh_key_store_get(store, 4));
+
+    for (int i = 0; i < 5; i++) {
+        stored = sidh_key_store_find(store, public_keys[i]);
+        assert_not_null(stored);
+        assert_memory_equal(PUBLIC_KEY_BYTES, stored->public_key, public_keys[i]);
+        assert_uint8(stored->valid, ==, (i != 4));
+        sidh_signature_prepare_public_key(&prepared, public_keys[i]);
+        assert_true(quadratic_field_is_equal(stored->A, prepared.A));
+    }
+    public_keys[0][0] ^= 0x01;
+    assert_null(sidh_key_store_find(store, public_keys[0]));
+    sidh_key_store_close(store);
+
+    // Truncated stores are refused
+    assert_int(truncate(path, KEY_STORE_HEADER_BYTES + 1), ==, 0);
+    assert_null(sidh_key_store_open(path));
+    // So are stores of another field
+    assert_uint8(EXIT_SUCCESS, ==, sidh_key_store_write(path, (const uint8_t *) public_keys, 5));
+    file = fopen(path, "r+b");
+    assert_not_null(file);
+    assert_int(fseek(file, 12, SEEK_SET), ==, 0);
+    assert_int(fputc(0xFF, file), !=, EOF);
+    fclose(file);
+    assert_null(sidh_key_store_open(path));
+
+    unlink(path);
+    return MUNIT_OK;
+}
+
+MunitTest test_key_store[] = {
+        TEST_CASE(key_store_write_and_open),
+        TEST_END
+};
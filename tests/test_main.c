@@ -1,14 +1,21 @@
 #include "test_declarations.h"
 #include "test_utils.h"
+#include "benchmark.h"
 
 
 // NOLINTNEXTLINE
 static MunitSuite benchmark_suites[] = {
         SUITE_IT("prime-fields/", benchmark_prime_fields, 10000),
         SUITE_IT("quadratic-fields/", benchmark_quadratic_fields, 10000),
+        SUITE("ecc/", benchmark_ecc),
+        SUITE("isogeny/", benchmark_isogeny),
         SUITE("sidh/", benchmark_sidh),
         SUITE("pok/", benchmark_pok),
         SUITE("signatures/", benchmark_signatures),
+        SUITE("strategy/", benchmark_strategy),
+        SUITE("throughput/", benchmark_throughput),
+        SUITE("counters/", benchmark_counters),
+        SUITE("memory/", benchmark_memory),
         SUITE_END
 };
 
@@ -21,6 +28,11 @@ static MunitSuite test_suites[] = {
         SUITE("sidh/", test_sidh),
         SUITE("pok/", test_pok),
         SUITE("signatures/", test_signature),
+        SUITE("fips202/", test_fips202),
+        SUITE("engine/", test_engine),
+        SUITE("daemon/", test_daemon),
+        SUITE("verify-cache/", test_verify_cache),
+        SUITE("key-store/", test_key_store),
         SUITE_END
 };
 
@@ -37,5 +49,5 @@ static const MunitSuite test_suite = {"", NULL, chained_suites, 0, MUNIT_SUITE_O
  */
 int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
 
-    return munit_suite_main(&test_suite, NULL, argc, argv);
+    return benchmark_finish(munit_suite_main_custom(&test_suite, NULL, argc, argv, benchmark_arguments));
 }
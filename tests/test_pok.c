@@ -279,6 +279,131 @@ static MunitResult test_two_dimensional_ladder(MUNIT_UNUSED const MunitParameter
     return MUNIT_OK;
 }
 
+static MunitResult test_two_dimensional_normalized_ladder(MUNIT_UNUSED const MunitParameter params[],
+                                                          MUNIT_UNUSED void *user_data_or_fixture) {
+    quadratic_field_element_t A;
+    sidh_private_key_t sk_alice;
+    sidh_public_key_t pk_alice, basis;
+    x_only_point_t S, T;
+    scalar_t c, d, order, k;
+    int bits;
+
+    //Seed generation
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    // Random supersingular Montgomery curve
+    sidh_generate_private_key_alice(&sk_alice, &shake_st);
+    sidh_get_public_key_from_private_key_alice(&pk_alice, &sk_alice);
+    get_curve_from_points(&A, pk_alice.P, pk_alice.Q, pk_alice.P_minus_Q);
+    assert_true(canonical_basis(&basis, A) == EXIT_SUCCESS);
+
+    scalar_power_of_three(order, EXPONENT_BOB);
+    random_bob_scalar(c);
+    random_bob_scalar(d);
+    // At least one unit is required: 3 ∤ c + 1 whenever 3 | c
+    if (multiprecision_modular_division(k, c, c, order, SUBGROUP_ORDER_64BITS_WORDS) == EXIT_FAILURE) {
+        memset(k, 0, sizeof(scalar_t));
+        k[0] = 1;
+        multiprecision_addition(c, c, k, SUBGROUP_ORDER_64BITS_WORDS);
+    }
+
+    two_dimensional_scalar_multiplication_bob(&T, basis.P, basis.Q, basis.P_minus_Q, c, d, A);
+    assert_true(two_dimensional_normalized_ladder_bob(&S, basis.P, basis.Q, basis.P_minus_Q, c, d, A) == EXIT_SUCCESS);
+
+    // [c]P + [d]Q = [c](P + [d/c]Q)
+    memcpy(k, c, sizeof(scalar_t));
+    bits = SUBGROUP_ORDER_BITS_BOB;
+    while (((k[(bits - 1) >> 6] >> ((bits - 1) & 63)) & 1) == 0) { bits--; }
+    x_only_ladder_bob(&S, S, k, bits, A);
+    assert_true(x_only_point_is_equal(S, T));
+
+    // [3]P + [c]Q = [c]([3/c]P + Q)
+    memset(d, 0, sizeof(scalar_t));
+    d[0] = 3;
+    two_dimensional_scalar_multiplication_bob(&T, basis.P, basis.Q, basis.P_minus_Q, d, c, A);
+    assert_true(two_dimensional_normalized_ladder_bob(&S, basis.P, basis.Q, basis.P_minus_Q, d, c, A) == EXIT_SUCCESS);
+    x_only_ladder_bob(&S, S, k, bits, A);
+    assert_true(x_only_point_is_equal(S, T));
+
+    // 3c and 3d give a non full-order point
+    memset(k, 0, sizeof(scalar_t));
+    k[0] = 3;
+    assert_true(two_dimensional_normalized_ladder_bob(&S, basis.P, basis.Q, basis.P_minus_Q, k, k, A) == EXIT_FAILURE);
+
+    // Scalars with the most significant bit set are out of range
+    memset(k, 0xFF, sizeof(scalar_t));
+    assert_true(two_dimensional_normalized_ladder_bob(&S, basis.P, basis.Q, basis.P_minus_Q, k, c, A) == EXIT_FAILURE);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_two_dimensional_normalized_ladder_pair(MUNIT_UNUSED const MunitParameter params[],
+                                                               MUNIT_UNUSED void *user_data_or_fixture) {
+    quadratic_field_element_t A[2], A_projective, C_projective;
+    sidh_private_key_t sk_alice;
+    sidh_public_key_t pk_alice, basis[2];
+    x_only_point_t P[2], Q[2], P_minus_Q[2], K[2], S;
+    scalar_t c, d, order, k;
+    uint8_t i;
+
+    //Seed generation
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    // Two random supersingular Montgomery curves, with projective bases for the pair and affine ones for the reference
+    for (i = 0; i < 2; i++) {
+        sidh_generate_private_key_alice(&sk_alice, &shake_st);
+        sidh_get_public_key_from_private_key_alice(&pk_alice, &sk_alice);
+        get_curve_from_points(&A[i], pk_alice.P, pk_alice.Q, pk_alice.P_minus_Q);
+        get_projective_curve_from_points(&A_projective, &C_projective, pk_alice.P, pk_alice.Q, pk_alice.P_minus_Q);
+        quadratic_field_multiplication(&C_projective, C_projective, A[i]);
+        assert_true(quadratic_field_is_equal(A_projective, C_projective));
+        assert_true(canonical_basis_projective(&P[i], &Q[i], &P_minus_Q[i], A[i]) == EXIT_SUCCESS);
+        assert_true(canonical_basis(&basis[i], A[i]) == EXIT_SUCCESS);
+    }
+
+    scalar_power_of_three(order, EXPONENT_BOB);
+    random_bob_scalar(c);
+    random_bob_scalar(d);
+    // At least one unit is required: 3 ∤ c + 1 whenever 3 | c
+    if (multiprecision_modular_division(k, c, c, order, SUBGROUP_ORDER_64BITS_WORDS) == EXIT_FAILURE) {
+        memset(k, 0, sizeof(scalar_t));
+        k[0] = 1;
+        multiprecision_addition(c, c, k, SUBGROUP_ORDER_64BITS_WORDS);
+    }
+
+    // P + [d/c]Q on each curve
+    assert_true(two_dimensional_normalized_ladder_bob_pair(K, P, Q, P_minus_Q, c, d, A) == EXIT_SUCCESS);
+    for (i = 0; i < 2; i++) {
+        assert_true(two_dimensional_normalized_ladder_bob(&S, basis[i].P, basis[i].Q, basis[i].P_minus_Q, c, d, A[i]) ==
+                    EXIT_SUCCESS);
+        assert_true(x_only_point_is_equal(K[i], S));
+    }
+
+    // Q + [c/d]P on each curve, with c = 3
+    memset(d, 0, sizeof(scalar_t));
+    d[0] = 3;
+    assert_true(two_dimensional_normalized_ladder_bob_pair(K, P, Q, P_minus_Q, d, c, A) == EXIT_SUCCESS);
+    for (i = 0; i < 2; i++) {
+        assert_true(two_dimensional_normalized_ladder_bob(&S, basis[i].P, basis[i].Q, basis[i].P_minus_Q, d, c, A[i]) ==
+                    EXIT_SUCCESS);
+        assert_true(x_only_point_is_equal(K[i], S));
+    }
+
+    // 3c and 3d give a non full-order point
+    assert_true(two_dimensional_normalized_ladder_bob_pair(K, P, Q, P_minus_Q, d, d, A) == EXIT_FAILURE);
+    return MUNIT_OK;
+}
+
 static MunitResult test_two_dimensional_pohlig_hellman(MUNIT_UNUSED const MunitParameter params[],
                                                        MUNIT_UNUSED void *user_data_or_fixture) {
     quadratic_field_element_t A, yP, yQ, zQ, t, y, x;
@@ -448,7 +573,7 @@ static MunitResult test_random_private_key_sample(MUNIT_UNUSED const MunitParame
 static MunitResult test_sidh_pok(MUNIT_UNUSED const MunitParameter params[],
                                  MUNIT_UNUSED void *user_data_or_fixture) {
     uint8_t value_equality, expected_value = EXIT_SUCCESS;
-    uint8_t commit[COMMITMENT_BYTES], inside[INSIGHT_BYTES], resp[RESPONSE_BYTES],
+    uint8_t commit[COMMITMENT_BYTES], recovered_commit[COMMITMENT_BYTES] = {0}, inside[INSIGHT_BYTES], resp[RESPONSE_BYTES],
             pk_alice_bytes[PUBLIC_KEY_BYTES], sk_alice_bytes[SECRET_KEY_BYTES_ALICE];
     sidh_public_key_t pk_alice;
     sidh_private_key_t sk_alice;
@@ -474,12 +599,114 @@ static MunitResult test_sidh_pok(MUNIT_UNUSED const MunitParameter params[],
 
     value_equality = sidh_pok_verification(commit, resp, pk_alice_bytes, 0);
     assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    // A tampered basis of E₃ must be rejected
+    commit[QUADRATIC_FIELD_BYTES] ^= 1;
+    assert_true(sidh_pok_verification(commit, resp, pk_alice_bytes, 0) == EXIT_FAILURE);
+    commit[QUADRATIC_FIELD_BYTES] ^= 1;
 
     value_equality = sidh_pok_response(resp, inside, 1);
     assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
 
     value_equality = sidh_pok_verification(commit, resp, pk_alice_bytes, 1);
     assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    commit[QUADRATIC_FIELD_BYTES] ^= 1;
+    assert_true(sidh_pok_verification(commit, resp, pk_alice_bytes, 1) == EXIT_FAILURE);
+    commit[QUADRATIC_FIELD_BYTES] ^= 1;
+
+    // Challenge-1 commitments are fully determined by E₂ and the response
+    memcpy(recovered_commit, commit, QUADRATIC_FIELD_BYTES);
+    value_equality = sidh_pok_commitment_recovery(recovered_commit, resp);
+    assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    assert_memory_equal(COMMITMENT_BYTES, commit, recovered_commit);
+    return EXIT_SUCCESS;
+}
+
+static MunitResult test_sidh_pok_insight(MUNIT_UNUSED const MunitParameter params[],
+                                         MUNIT_UNUSED void *user_data_or_fixture) {
+    uint8_t commit[COMMITMENT_BYTES], commit_bytes[COMMITMENT_BYTES], inside[INSIGHT_BYTES],
+            inside_bytes[INSIGHT_BYTES], resp[RESPONSE_BYTES], resp_bytes[RESPONSE_BYTES],
+            sk_alice_bytes[SECRET_KEY_BYTES_ALICE];
+    sidh_pok_insight_t insight, insight_copy;
+    sidh_private_key_t sk_alice;
+    projective_point_t workspace[POHLIG_HELLMAN_WORKSPACE_POINTS];
+    keccak_state shake_st_copy;
+
+    //Seed generation
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    sidh_generate_private_key_alice(&sk_alice, &shake_st);
+    memcpy(sk_alice_bytes, (const uint8_t *) sk_alice.key, SECRET_KEY_BYTES_ALICE);
+
+    // In-memory and serialized insights agree
+    memcpy(&shake_st_copy, &shake_st, sizeof(shake_st));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_pok_commitment_insight(commit, &insight, sk_alice_bytes, &shake_st));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_pok_commitment(commit_bytes, inside_bytes, sk_alice_bytes, &shake_st_copy));
+    assert_memory_equal(COMMITMENT_BYTES, commit, commit_bytes);
+    sidh_pok_insight_to_bytes(inside, &insight);
+    assert_memory_equal(INSIGHT_BYTES, inside, inside_bytes);
+    sidh_pok_insight_from_bytes(&insight_copy, inside);
+    assert_memory_equal(sizeof(insight), &insight, &insight_copy);
+
+    for (uint8_t challenge = 0; challenge < 2; challenge++) {
+        assert_uint8(EXIT_SUCCESS, ==, sidh_pok_response_insight(resp, &insight, challenge, workspace));
+        assert_uint8(EXIT_SUCCESS, ==, sidh_pok_response(resp_bytes, inside_bytes, challenge));
+        assert_memory_equal(RESPONSE_BYTES, resp, resp_bytes);
+    }
+    return EXIT_SUCCESS;
+}
+
+static MunitResult test_sidh_pok_compression(MUNIT_UNUSED const MunitParameter params[],
+                                             MUNIT_UNUSED void *user_data_or_fixture) {
+    uint8_t value_equality, expected_value = EXIT_SUCCESS;
+    uint8_t commit[COMMITMENT_BYTES], decompressed_commit[COMMITMENT_BYTES], inside[INSIGHT_BYTES],
+            compressed_commit[COMPRESSED_COMMITMENT_BYTES], pk_alice_bytes[PUBLIC_KEY_BYTES],
+            decompressed_pk[PUBLIC_KEY_BYTES], compressed_pk[COMPRESSED_PUBLIC_KEY_BYTES],
+            sk_alice_bytes[SECRET_KEY_BYTES_ALICE];
+    sidh_public_key_t pk_alice;
+    sidh_private_key_t sk_alice;
+
+    //Seed generation
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    sidh_generate_private_key_alice(&sk_alice, &shake_st);
+    memcpy(sk_alice_bytes, (const uint8_t *) sk_alice.key, SECRET_KEY_BYTES_ALICE);
+    sidh_get_public_key_from_private_key_alice(&pk_alice, &sk_alice);
+    sidh_public_key_to_bytes(pk_alice_bytes, &pk_alice);
+
+    value_equality = sidh_public_key_compress(compressed_pk, pk_alice_bytes);
+    assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    value_equality = sidh_public_key_decompress(decompressed_pk, compressed_pk);
+    assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    assert_memory_equal(PUBLIC_KEY_BYTES, pk_alice_bytes, decompressed_pk);
+
+    // Malformed keys: scalars of 3ᵇ or more (all bits set included), and a zero pair of scalars
+    uint8_t malformed_pk[COMPRESSED_PUBLIC_KEY_BYTES];
+    scalar_t three_to_b = {0};
+    scalar_power_of_three(three_to_b, EXPONENT_BOB);
+    memcpy(malformed_pk, compressed_pk, COMPRESSED_PUBLIC_KEY_BYTES);
+    memcpy(&malformed_pk[QUADRATIC_FIELD_BYTES], (uint8_t *) three_to_b, SECRET_KEY_BYTES_BOB);
+    assert_uint8(EXIT_FAILURE, ==, sidh_public_key_decompress(decompressed_pk, malformed_pk));
+    memset(&malformed_pk[QUADRATIC_FIELD_BYTES], 0xFF, SECRET_KEY_BYTES_BOB);
+    assert_uint8(EXIT_FAILURE, ==, sidh_public_key_decompress(decompressed_pk, malformed_pk));
+    memset(&malformed_pk[QUADRATIC_FIELD_BYTES], 0, 2 * SECRET_KEY_BYTES_BOB);
+    assert_uint8(EXIT_FAILURE, ==, sidh_public_key_decompress(decompressed_pk, malformed_pk));
+
+    sidh_pok_commitment(commit, inside, sk_alice_bytes, &shake_st);
+    value_equality = sidh_pok_commitment_compress(compressed_commit, commit);
+    assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    value_equality = sidh_pok_commitment_decompress(decompressed_commit, compressed_commit);
+    assert_memory_equal(sizeof(uint8_t), &expected_value, &value_equality);
+    assert_memory_equal(COMMITMENT_BYTES, commit, decompressed_commit);
     return EXIT_SUCCESS;
 }
 
@@ -494,9 +721,13 @@ MunitTest test_pok[] = {
         TEST_CASE(test_canonical_basis_bob),
         TEST_CASE(test_canonical_basisx),
         TEST_CASE(test_two_dimensional_ladder),
+        TEST_CASE(test_two_dimensional_normalized_ladder),
+        TEST_CASE(test_two_dimensional_normalized_ladder_pair),
         TEST_CASE(test_two_dimensional_pohlig_hellman),
         TEST_CASE(test_random_private_key_sample),
         TEST_CASE(test_sidh_pok),
+        TEST_CASE(test_sidh_pok_insight),
+        TEST_CASE(test_sidh_pok_compression),
         TEST_END
 };
 
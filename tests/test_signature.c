@@ -40,6 +40,36 @@ static MunitResult key_generation(MUNIT_UNUSED const MunitParameter params[],
     return MUNIT_OK;
 }
 
+static MunitResult key_generation_batch(MUNIT_UNUSED const MunitParameter params[],
+                                        MUNIT_UNUSED void *user_data_or_fixture) {
+    uint8_t private_keys[3][SECRET_KEY_BYTES] = {{0}};
+    uint8_t public_keys[3][PUBLIC_KEY_BYTES] = {{0}};
+    uint8_t private_key[SECRET_KEY_BYTES] = {0};
+    uint8_t public_key[PUBLIC_KEY_BYTES] = {0};
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    keccak_state shake_st_copy;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+    memcpy(&shake_st_copy, &shake_st, sizeof(shake_st));
+
+    // Two threads over three keys: matches the one-at-a-time keys drawn from the same state
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_key_generation_batch((uint8_t *) private_keys, (uint8_t *) public_keys, 3,
+                                                     &shake_st, 2));
+    for (int i = 0; i < 3; i++) {
+        assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(private_key, public_key, &shake_st_copy));
+        assert_memory_equal(SECRET_KEY_BYTES, private_keys[i], private_key);
+        assert_memory_equal(PUBLIC_KEY_BYTES, public_keys[i], public_key);
+    }
+    assert_memory_equal(sizeof(keccak_state), &shake_st, &shake_st_copy);
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation_batch(NULL, NULL, 0, &shake_st, 0));
+
+    return MUNIT_OK;
+}
 
 static MunitResult sidh_signature(MUNIT_UNUSED const MunitParameter params[],
                                   MUNIT_UNUSED void *user_data_or_fixture) {
@@ -67,11 +97,201 @@ static MunitResult sidh_signature(MUNIT_UNUSED const MunitParameter params[],
                        sidh_signature_sign(signature, message, message_length, private_key, public_key,
                                            &shake_st));
     assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verify(signature, message, message_length, public_key));
+
+    // Streaming digest of the same message
+    uint8_t digest[MESSAGE_DIGEST_BYTES];
+    sidh_digest_state_t digest_st;
+    sidh_message_digest_init(&digest_st);
+    sidh_message_digest_update(&digest_st, message, 1);
+    sidh_message_digest_update(&digest_st, &message[1], 8999);
+    sidh_message_digest_update(&digest_st, &message[9000], message_length - 9000);
+    assert_uint8(EXIT_SUCCESS, ==, sidh_message_digest_final(digest, &digest_st));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verify_digest(signature, digest, public_key));
+    // An empty stream is refused, as an empty message is by sidh_signature_sign
+    sidh_digest_state_t empty_st;
+    uint8_t empty_digest[MESSAGE_DIGEST_BYTES];
+    sidh_message_digest_init(&empty_st);
+    sidh_message_digest_update(&empty_st, message, 0);
+    assert_uint8(EXIT_FAILURE, ==, sidh_message_digest_final(empty_digest, &empty_st));
+
+    // Streaming verification, with chunks splitting commitments and responses
+    sidh_signature_verifier_t *verifier = malloc(sizeof(sidh_signature_verifier_t));
+    uint64_t position, chunk;
+    assert_not_null(verifier);
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verifier_init(verifier, digest, public_key));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verifier_update(verifier, signature, 1));
+    for (position = 1; position < SIGNATURE_BYTES; position += chunk) {
+        chunk = (SIGNATURE_BYTES - position < COMMITMENT_BYTES + 7) ? SIGNATURE_BYTES - position : COMMITMENT_BYTES + 7;
+        assert_uint8(EXIT_FAILURE, ==, sidh_signature_verifier_final(verifier));
+        assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verifier_update(verifier, &signature[position], chunk));
+    }
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verifier_final(verifier));
+    // Extra bytes are rejected
+    assert_uint8(EXIT_FAILURE, ==, sidh_signature_verifier_update(verifier, signature, 1));
+    assert_uint8(EXIT_FAILURE, ==, sidh_signature_verifier_final(verifier));
+
+    // Fail-fast verification agrees, and rejects a forged challenge-1 response
+    uint8_t challenge_bytes[SECURITY_BITS / 8];
+    uint16_t round = 0;
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verify_fail_fast(signature, message, message_length, public_key));
+    sidh_signature_challenge(challenge_bytes, signature, message, message_length, public_key);
+    while (!((challenge_bytes[round / 8] >> (round % 8)) & 1)) { round++; }
+    signature[(COMMITMENT_BYTES * SECURITY_BITS) + (RESPONSE_BYTES * round)] ^= 0x01;
+    assert_uint8(EXIT_FAILURE, ==, sidh_signature_verify_fail_fast(signature, message, message_length, public_key));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verifier_init(verifier, digest, public_key));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_verifier_update(verifier, signature, SIGNATURE_BYTES));
+    assert_uint8(EXIT_FAILURE, ==, sidh_signature_verifier_final(verifier));
+    free(verifier);
+    return MUNIT_OK;
+}
+
+static MunitResult message_digest(MUNIT_UNUSED const MunitParameter params[],
+                                  MUNIT_UNUSED void *user_data_or_fixture) {
+    const uint64_t lengths[] = {0, 100, TREE_DIGEST_LEAF_BYTES, (4 * TREE_DIGEST_LEAF_BYTES) + 17,
+                                (600 * TREE_DIGEST_LEAF_BYTES) + 5};
+    const uint64_t chunks[] = {1, 4095, 3 * TREE_DIGEST_LEAF_BYTES, 5 * TREE_DIGEST_LEAF_BYTES + 1};
+    uint64_t maximum_length = lengths[4], position, chunk;
+    uint8_t *message = malloc(maximum_length);
+    uint8_t expected[MESSAGE_DIGEST_BYTES], digest[MESSAGE_DIGEST_BYTES];
+    sidh_digest_state_t state;
+
+    munit_rand_memory(maximum_length, message);
+    for (unsigned i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        sidh_tree_digest(expected, message, lengths[i], 1);
+
+        // Any thread count gives the same digest
+        for (unsigned threads = 0; threads < 4; threads++) {
+            sidh_tree_digest(digest, message, lengths[i], threads);
+            assert_memory_equal(MESSAGE_DIGEST_BYTES, digest, expected);
+        }
+
+        // So does any chunking of the stream
+        for (unsigned j = 0; j < sizeof(chunks) / sizeof(chunks[0]); j++) {
+            sidh_tree_digest_init(&state);
+            for (position = 0; position < lengths[i]; position += chunk) {
+                chunk = (lengths[i] - position < chunks[j]) ? lengths[i] - position : chunks[j];
+                sidh_tree_digest_update(&state, &message[position], chunk);
+            }
+            sidh_tree_digest_final(digest, &state);
+            assert_memory_equal(MESSAGE_DIGEST_BYTES, digest, expected);
+        }
+
+        // The tree digest is a different function from the flat one
+        shake256(digest, MESSAGE_DIGEST_BYTES, message, lengths[i]);
+        assert_memory_not_equal(MESSAGE_DIGEST_BYTES, digest, expected);
+
+        sidh_message_digest(digest, message, lengths[i]);
+#ifdef TREE_DIGEST
+        assert_memory_equal(MESSAGE_DIGEST_BYTES, digest, expected);
+#else
+        shake256(expected, MESSAGE_DIGEST_BYTES, message, lengths[i]);
+        assert_memory_equal(MESSAGE_DIGEST_BYTES, digest, expected);
+#endif
+    }
+    free(message);
+    return MUNIT_OK;
+}
+
+static MunitResult sidh_signature_compact(MUNIT_UNUSED const MunitParameter params[],
+                                          MUNIT_UNUSED void *user_data_or_fixture) {
+    uint64_t message_length = 10000, compact_signature_length = 0;
+    uint8_t private_key[SECRET_KEY_BYTES] = {0};
+    uint8_t public_key[PUBLIC_KEY_BYTES] = {0};
+    uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES] = {0};
+    uint8_t message[message_length];
+
+    memset(message, 0, message_length);
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(private_key, public_key, &shake_st));
+
+    seed[0]++;
+    shake256(message, sizeof(message), seed, sizeof(seed));
+
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_sign_compact(compact_signature, &compact_signature_length, message, message_length,
+                                             private_key, public_key, &shake_st));
+    assert_uint64(compact_signature_length, >=, COMPACT_SIGNATURE_MIN_BYTES);
+    assert_uint64(compact_signature_length, <, SIGNATURE_BYTES);
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_verify_compact(compact_signature, compact_signature_length, message, message_length,
+                                               public_key));
+    // Layout no longer matches the challenge
+    compact_signature[0] ^= 0x01;
+    assert_uint8(EXIT_SUCCESS, !=,
+                 sidh_signature_verify_compact(compact_signature, compact_signature_length, message, message_length,
+                                               public_key));
+    return MUNIT_OK;
+}
+
+static MunitResult sidh_signature_workspace(MUNIT_UNUSED const MunitParameter params[],
+                                            MUNIT_UNUSED void *user_data_or_fixture) {
+    static _Alignas(SIGNATURE_WORKSPACE_ALIGNMENT) uint8_t workspace[SIGNATURE_WORKSPACE_BYTES];
+    uint64_t message_length = 10000, compact_signature_length = 0;
+    uint8_t private_key[SECRET_KEY_BYTES] = {0};
+    uint8_t public_key[PUBLIC_KEY_BYTES] = {0};
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t signature_workspace[SIGNATURE_BYTES] = {0};
+    uint8_t compact_signature[COMPACT_SIGNATURE_MAX_BYTES] = {0};
+    uint8_t message[message_length];
+
+    memset(message, 0, message_length);
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    keccak_state shake_st_copy;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    assert_size(sidh_signature_workspace_bytes(), ==, SIGNATURE_WORKSPACE_BYTES);
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(private_key, public_key, &shake_st));
+
+    seed[0]++;
+    shake256(message, sizeof(message), seed, sizeof(seed));
+
+    // Same randomness, same signature as the stack-allocating variant
+    memcpy(&shake_st_copy, &shake_st, sizeof(shake_st));
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_sign(signature, message, message_length, private_key, public_key, &shake_st));
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_sign_workspace(signature_workspace, message, message_length, private_key, public_key,
+                                               &shake_st_copy, workspace, sizeof(workspace)));
+    assert_memory_equal(SIGNATURE_BYTES, signature, signature_workspace);
+
+    // The workspace is reused as is
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_sign_compact_workspace(compact_signature, &compact_signature_length, message,
+                                                       message_length, private_key, public_key, &shake_st,
+                                                       workspace, sizeof(workspace)));
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_verify_compact_workspace(compact_signature, compact_signature_length, message,
+                                                         message_length, public_key, workspace, sizeof(workspace)));
+
+    // Too small or misaligned workspaces are rejected
+    assert_uint8(EXIT_SUCCESS, !=,
+                 sidh_signature_verify_compact_workspace(compact_signature, compact_signature_length, message,
+                                                         message_length, public_key, workspace, sizeof(workspace) - 1));
+    assert_uint8(EXIT_SUCCESS, !=,
+                 sidh_signature_verify_compact_workspace(compact_signature, compact_signature_length, message,
+                                                         message_length, public_key, &workspace[1],
+                                                         sizeof(workspace) - SIGNATURE_WORKSPACE_ALIGNMENT));
     return MUNIT_OK;
 }
 
 MunitTest test_signature[] = {
         TEST_CASE(key_generation),
+        TEST_CASE(key_generation_batch),
         TEST_CASE(sidh_signature),
+        TEST_CASE(sidh_signature_compact),
+        TEST_CASE(sidh_signature_workspace),
+        TEST_CASE(message_digest),
         TEST_END
 };
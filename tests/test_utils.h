@@ -54,6 +54,17 @@ static void random_bob_private_key(uint64_t output[SUBGROUP_ORDER_64BITS_WORDS])
     output[SUBGROUP_ORDER_64BITS_WORDS - 1] &= MASK_BOB_64BITS;
 }
 
+// Reduced scalar modulo 3ᵇ
+static void random_bob_scalar(uint64_t output[SUBGROUP_ORDER_64BITS_WORDS]) {
+    uint64_t order[SUBGROUP_ORDER_64BITS_WORDS];
+    scalar_power_of_three(order, EXPONENT_BOB);
+    memset(output, 0, sizeof(uint64_t) * SUBGROUP_ORDER_64BITS_WORDS);
+    do {
+        munit_rand_memory(SECRET_KEY_BYTES_BOB, (munit_uint8_t *) output);
+        ((uint8_t *) output)[SECRET_KEY_BYTES_BOB - 1] &= MASK_BOB;
+    } while (!multiprecision_is_smaller(output, order, SUBGROUP_ORDER_64BITS_WORDS));
+}
+
 static void initialize_generators_alice(quadratic_field_element_t *P, quadratic_field_element_t *Q,
                                  quadratic_field_element_t *P_minus_Q) {
     prime_field_copy(P->re, PUBLIC_POINT_GENERATORS_ALICE);
@@ -0,0 +1,92 @@
+#include "test_declarations.h"
+#include "test_utils.h"
+#include <verify_cache.h>
+
+static MunitResult verify_cache_eviction(MUNIT_UNUSED const MunitParameter params[],
+                                         MUNIT_UNUSED void *user_data_or_fixture) {
+    sidh_verify_cache_t *cache = sidh_verify_cache_create(4096);
+    sidh_verify_cache_stats_t stats;
+    uint8_t key[VERIFY_CACHE_KEY_BYTES];
+    uint64_t capacity;
+
+    assert_null(sidh_verify_cache_create(16));
+    assert_not_null(cache);
+    sidh_verify_cache_get_stats(cache, &stats);
+    capacity = stats.capacity;
+    assert_uint64(capacity, >=, 2);
+
+    // Keys 0 .. capacity - 1, then key 0 becomes the most recently used
+    memset(key, 0, sizeof(key));
+    for (uint64_t i = 0; i < capacity; i++) {
+        memcpy(key, &i, sizeof(i));
+        sidh_verify_cache_insert(cache, key);
+    }
+    memset(key, 0, sizeof(key));
+    assert_uint8(1, ==, sidh_verify_cache_lookup(cache, key));
+
+    // One more key evicts key 1, the least recently used
+    uint64_t extra = capacity;
+    memcpy(key, &extra, sizeof(extra));
+    sidh_verify_cache_insert(cache, key);
+    assert_uint8(1, ==, sidh_verify_cache_lookup(cache, key));
+    for (uint64_t i = 0; i < capacity; i++) {
+        memcpy(key, &i, sizeof(i));
+        assert_uint8((i != 1), ==, sidh_verify_cache_lookup(cache, key));
+    }
+
+    sidh_verify_cache_get_stats(cache, &stats);
+    assert_uint64(stats.entries, ==, capacity);
+    assert_uint64(stats.insertions, ==, capacity + 1);
+    assert_uint64(stats.evictions, ==, 1);
+    assert_uint64(stats.hits, ==, capacity + 1);
+    assert_uint64(stats.misses, ==, 1);
+
+    sidh_verify_cache_destroy(cache);
+    return MUNIT_OK;
+}
+
+static MunitResult verify_cache_signature(MUNIT_UNUSED const MunitParameter params[],
+                                          MUNIT_UNUSED void *user_data_or_fixture) {
+    uint64_t message_length = 1000;
+    uint8_t private_key[SECRET_KEY_BYTES] = {0};
+    uint8_t public_key[PUBLIC_KEY_BYTES] = {0};
+    uint8_t signature[SIGNATURE_BYTES] = {0};
+    uint8_t message[message_length];
+    sidh_verify_cache_t *cache = sidh_verify_cache_create(1 << 16);
+    sidh_verify_cache_stats_t stats;
+
+    uint8_t seed[SECURITY_BITS / 8] = {0};
+    RANDOM_SEED(seed)
+    keccak_state shake_st;
+    shake256_init(&shake_st);
+    shake256_absorb(&shake_st, (uint8_t *) seed, sizeof(seed));
+    shake256_finalize(&shake_st);
+
+    assert_uint8(EXIT_SUCCESS, ==, sidh_signature_key_generation(private_key, public_key, &shake_st));
+    seed[0]++;
+    shake256(message, sizeof(message), seed, sizeof(seed));
+    assert_uint8(EXIT_SUCCESS, ==,
+                 sidh_signature_sign(signature, message, message_length, private_key, public_key, &shake_st));
+
+    // Miss then hit
+    assert_uint8(EXIT_SUCCESS, ==, sidh_verify_cache_verify(cache, signature, message, message_length, public_key));
+    assert_uint8(EXIT_SUCCESS, ==, sidh_verify_cache_verify(cache, signature, message, message_length, public_key));
+
+    // Another message is a miss, fails, and is not cached
+    message[0] ^= 0x01;
+    assert_uint8(EXIT_FAILURE, ==, sidh_verify_cache_verify(cache, signature, message, message_length, public_key));
+
+    sidh_verify_cache_get_stats(cache, &stats);
+    assert_uint64(stats.hits, ==, 1);
+    assert_uint64(stats.misses, ==, 2);
+    assert_uint64(stats.entries, ==, 1);
+
+    sidh_verify_cache_destroy(cache);
+    return MUNIT_OK;
+}
+
+MunitTest test_verify_cache[] = {
+        TEST_CASE(verify_cache_eviction),
+        TEST_CASE(verify_cache_signature),
+        TEST_END
+};